@@ -0,0 +1,107 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "boilerplateCodeDoc.h"
+#include "allocationCounter.h"
+
+namespace boiler = boilerplateCodeDoc;
+
+// bytes requested by every allocation of the process, whatever it is freed or not
+static size_t allocated()
+{
+   return boiler::allocationCounters().bytes;
+}
+
+// build/benchmark/BoilerplateCodeDoc_benchmark [<breadth> <depth>]
+// make launchBoilerplateCodeDoc_benchmark
+// reference.txt: the baseline tool timed on the same shapes, to compare with
+
+template<typename F>
+static double milliseconds(F&& f)
+{
+   auto start = std::chrono::steady_clock::now();
+   f();
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool benchmark(size_t breadth, size_t depth)
+{
+   std::string filename {"benchmark_" + std::to_string(breadth) + "_" + std::to_string(depth) + ".json"};
+   boiler::JsonSchemaSynthetic shape {};
+   shape.depth = depth;
+   shape.breadth = breadth;
+   shape.one_of = 0;
+   size_t properties {shape.properties()};
+   {
+	std::string json {boiler::syntheticSchema(shape)};
+	std::ofstream{filename}.write(json.c_str(), json.size());
+   }
+
+   bool result {true};
+   double load {}, html {}, h {}, cpp {};
+   size_t loadBytes {}, filterBytes {};
+#if defined(__GLIBC__)
+   malloc_trim(0); // memory freed by previous schemas not counted again
+#endif
+   boiler::JsonSchemaStats::resetPeak();
+   {
+	boiler::JsonSchema* jsonSchema {nullptr};
+	size_t before {allocated()};
+	load = milliseconds([&]{ jsonSchema = new boiler::JsonSchema{filename}; });
+	loadBytes = allocated() - before;
+	before = allocated();
+	if( jsonSchema->error != boiler::ParseErrorCode::OK ) {
+		std::cout << jsonSchema->message << std::endl;
+		result = false;
+	} else {
+		boiler::JsonSchema2HTML htmlFilter {};
+		html = milliseconds([&]{ result = htmlFilter(*jsonSchema) && result; });
+		boiler::JsonSchema2H hFilter {};
+		h = milliseconds([&]{ result = hFilter(*jsonSchema) && result; });
+		boiler::JsonSchema2CPP cppFilter {};
+		cpp = milliseconds([&]{ result = cppFilter(*jsonSchema) && result; });
+	}
+	filterBytes = allocated() - before;
+	delete jsonSchema;
+   }
+   size_t peakKiB {boiler::JsonSchemaStats::peak()};
+   std::remove(filename.c_str());
+
+   double total {load + html + h + cpp};
+   std::cout << std::setw(8) << breadth << std::setw(6) << depth << std::setw(10) << properties
+	     << std::fixed << std::setprecision(2)
+	     << std::setw(12) << load << std::setw(12) << html << std::setw(12) << h << std::setw(12) << cpp
+	     << std::setw(14) << (total * 1e6 / properties)
+	     << std::setw(12) << loadBytes / 1024 << std::setw(12) << filterBytes / 1024 << std::setw(12) << peakKiB << std::endl;
+   return result;
+}
+
+int main(int argc, char** argv)
+{
+   boiler::allocationCounting(true);
+   std::vector<std::pair<size_t, size_t>> sizes { {100, 1}, {1000, 1}, {10000, 1}, {100000, 1}, {10, 6}, {10, 9}, {10, 12}, {10, 14} };
+   if( argc == 3 ) {
+	sizes = { {std::strtoul(argv[1], nullptr, 10), std::strtoul(argv[2], nullptr, 10)} };
+   } else if( argc != 1 ) {
+	std::cout << "Usage:\n\n" << argv[0] << " [<breadth> <depth>]\n\n";
+	return 1;
+   }
+
+   std::cout << std::setw(8) << "breadth" << std::setw(6) << "depth" << std::setw(10) << "props"
+	     << std::setw(12) << "load ms" << std::setw(12) << "html ms" << std::setw(12) << "h ms" << std::setw(12) << "cpp ms"
+	     << std::setw(14) << "ns/property"
+	     << std::setw(12) << "load KiB" << std::setw(12) << "filter KiB" << std::setw(12) << "peak KiB" << std::endl;
+
+   bool result {true};
+   for(const auto& s : sizes) { result = benchmark(s.first, s.second) && result; }
+   return result ? 0 : 1;
+}
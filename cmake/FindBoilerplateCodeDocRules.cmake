@@ -120,10 +120,13 @@ set(${LOCAL_CMAKE_PROJECT_NAME}_STATIC_LIB "${CMAKE_CURRENT_BINARY_DIR}/${LOCAL_
 set(${LOCAL_CMAKE_PROJECT_NAME}_INCLUDE_DIR "${CMAKE_CURRENT_SOURCE_DIR}/${LOCAL_CMAKE_PROJECT_NAME}/include")
 set(LIB_SHARED_NAME "${LOCAL_CMAKE_PROJECT_NAME}")
 set(TEST_NAME "${LOCAL_CMAKE_PROJECT_NAME}_test")
+set(BENCHMARK_NAME "${LOCAL_CMAKE_PROJECT_NAME}_benchmark")
 set(TOOL_NAME "${LOCAL_CMAKE_PROJECT_NAME}_tool")
 set(TOOL_INPUT_FILE "${CMAKE_CURRENT_SOURCE_DIR}/json/schema.json")
 set(TOOL_CPP_OUTPUT_FILE "${CMAKE_CURRENT_BINARY_DIR}/${LOCAL_CMAKE_PROJECT_NAME}.h")
 set(TOOL_HTML_OUTPUT_FILE "${CMAKE_CURRENT_BINARY_DIR}/${LOCAL_CMAKE_PROJECT_NAME}.html")
+set(TOOL_CPP_SOURCE_OUTPUT_FILE "${CMAKE_CURRENT_BINARY_DIR}/${LOCAL_CMAKE_PROJECT_NAME}.cpp")
+set(TOOL_CACHE_DIR "${CMAKE_CURRENT_BINARY_DIR}/cache") # environment, not option: older tools just ignore it
 
 ###############################################
 # html & cpp code generation by external tool #
@@ -147,7 +150,7 @@ function(locate_boilerplate_tool TOOL_NAME TOOL_DIR TOOL_SOURCE_DIR TOOL_INCLUDE
 	-o ${TOOL_DIR_VAR}/${TOOL_NAME_VAR}
 	-I${TOOL_INCLUDE_DIR} -I${TOOL_SOURCE_DIR}/.
 	${TOOL_SOURCE_FILES})
-    execute_process(COMMAND ${EXECUTE_COMMAND} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR} TIMEOUT 5
+    execute_process(COMMAND ${EXECUTE_COMMAND} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR} TIMEOUT 60
 	RESULT_VARIABLE TOOL_BINARY_RESULT OUTPUT_VARIABLE TOOL_BINARY_OUTPUT ERROR_VARIABLE TOOL_BINARY_ERROR)
     find_program(TOOL_BINARY_VAR NAME ${TOOL_NAME_VAR} HINTS ${TOOL_DIR_VAR})
  endif()
@@ -177,18 +180,30 @@ endif(EXISTS ${TOOL_DIR})
 ## tool binary
 locate_boilerplate_tool(${TOOL_NAME} ${TOOL_DIR} "${CMAKE_CURRENT_SOURCE_DIR}/src" "${CMAKE_CURRENT_SOURCE_DIR}/include" TOOL_BINARY)
 
+## prebuilt tools older than the C++ source output take only three arguments: their usage tells
+execute_process(COMMAND ${TOOL_BINARY} TIMEOUT 5 OUTPUT_VARIABLE TOOL_USAGE ERROR_QUIET)
+if(TOOL_USAGE MATCHES "C\\+\\+ source Output File Name")
+    set(TOOL_CPP_SOURCE_ARGUMENT "${TOOL_CPP_SOURCE_OUTPUT_FILE}")
+else()
+    set(TOOL_CPP_SOURCE_ARGUMENT "")
+    message(STATUS "Tool without C++ source output: ${TOOL_CPP_SOURCE_OUTPUT_FILE} not generated")
+endif()
+
 ## Now that tool is found or created, high time to use it!
-execute_process(COMMAND ${TOOL_BINARY} ${TOOL_INPUT_FILE} ${TOOL_HTML_OUTPUT_FILE} ${TOOL_CPP_OUTPUT_FILE} TIMEOUT 5
+execute_process(COMMAND ${CMAKE_COMMAND} -E env JSONSCHEMA2CPP_CACHE=${TOOL_CACHE_DIR} ${TOOL_BINARY} ${TOOL_INPUT_FILE} ${TOOL_HTML_OUTPUT_FILE} ${TOOL_CPP_OUTPUT_FILE} ${TOOL_CPP_SOURCE_ARGUMENT} TIMEOUT 5
     RESULT_VARIABLE TOOL_BINARY_RESULT OUTPUT_VARIABLE TOOL_BINARY_OUTPUT ERROR_VARIABLE TOOL_BINARY_ERROR)
 if(TOOL_BINARY_RESULT)
     message(FATAL_ERROR "Unable to generated C++/HTML code")
 else()
     message(STATUS "Generated HTML: ${TOOL_HTML_OUTPUT_FILE}")
     message(STATUS "Generated C++: ${TOOL_CPP_OUTPUT_FILE}")
+    if(TOOL_CPP_SOURCE_ARGUMENT)
+      message(STATUS "Generated C++: ${TOOL_CPP_SOURCE_OUTPUT_FILE}")
+    endif()
 endif()
 
 ## Create a target to relaunch the tool later on
-add_custom_target(launch${TOOL_NAME} ALL ${TOOL_BINARY} ${TOOL_INPUT_FILE} ${TOOL_HTML_OUTPUT_FILE} ${TOOL_CPP_OUTPUT_FILE} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+add_custom_target(launch${TOOL_NAME} ALL ${CMAKE_COMMAND} -E env JSONSCHEMA2CPP_CACHE=${TOOL_CACHE_DIR} ${TOOL_BINARY} ${TOOL_INPUT_FILE} ${TOOL_HTML_OUTPUT_FILE} ${TOOL_CPP_OUTPUT_FILE} ${TOOL_CPP_SOURCE_ARGUMENT} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
 
 ### Install ###
 if(DEFINED ENV{INSTALL_PREFIX})
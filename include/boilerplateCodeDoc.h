@@ -10,8 +10,15 @@
 #ifndef BOILERPLATECODEDOC_H
 #define BOILERPLATECODEDOC_H
 
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
+#include <initializer_list>
 
 /// @brief Decouple User Output for the simple example.
 /// @remark long name on propose in order to avoid name collisions.
@@ -27,6 +34,223 @@ namespace boilerplateCodeDoc {
 					  ERROR_FILTERING_DOCUMENT
 					};
 
+    /// @brief Handle of an interned string: 0 is always the empty string.
+    using JsonSchemaStringId = std::uint32_t;
+
+    /// @brief Every distinct string of the intermediate representation is stored only once.
+    /// @remark Characters are copied into big blocks that never move, so the views are stable.
+    struct JsonSchemaStrings {
+
+      ///@brief handle 0 is already the empty string
+      JsonSchemaStrings();
+
+      ///@brief handle of that value, stored only the first time it is seen
+      JsonSchemaStringId intern(std::string_view value);
+
+      ///@brief interned value
+      std::string_view operator[](JsonSchemaStringId id) const { return views[id]; }
+
+      ///@brief forget every value but the empty string, keeping some storage for the next ones
+      void clear();
+
+      ///@brief characters allocated per block, unless a single string is even bigger
+      static constexpr size_t BLOCK_SIZE {64 * 1024};
+
+      ///@brief value of every handle
+      std::vector<std::string_view> views {};
+
+      ///@brief storage of the characters
+      std::vector<std::unique_ptr<char[]>> blocks {};
+
+      ///@brief characters already used in the last block
+      size_t used {BLOCK_SIZE};
+
+      ///@brief handle of every value
+      std::unordered_map<std::string_view, JsonSchemaStringId> lookup {};
+    };
+
+    /// @brief Resolved property of a schema object.
+    /// @remark Part of the intermediate representation shared by all the filters: strings live in JsonSchema::strings.
+    struct JsonSchemaProperty {
+
+      ///@brief Mentioned by 'required' or 'oneOf'
+      bool required {false};
+
+      ///@brief Not flagged as 'not implemented' by its metainfo
+      bool implemented {true};
+
+      ///@brief Property name
+      JsonSchemaStringId name {0};
+
+      ///@brief Explicit scope, otherwise "required" or "optional"
+      JsonSchemaStringId scope {0};
+
+      ///@brief Json Schema type
+      JsonSchemaStringId type {0};
+
+      ///@brief Optional description
+      JsonSchemaStringId description {0};
+
+      ///@brief Optional title
+      JsonSchemaStringId title {0};
+
+      ///@brief C++ type to be generated
+      JsonSchemaStringId cpptype {0};
+
+      ///@brief Json type used to access its value
+      JsonSchemaStringId jsontype {0};
+
+      ///@brief Optional extra info
+      JsonSchemaStringId metainfo {0};
+
+      ///@brief HTML internal link to the table of its own properties
+      JsonSchemaStringId bookmark_source {0};
+    };
+
+    /// @brief Schema object whose properties are filtered together.
+    /// @remark Its members are shared by all its properties, so they are stored only once here.
+    struct JsonSchemaObject {
+
+      ///@brief rapidjson::pointer like name of the object
+      JsonSchemaStringId element {0};
+
+      ///@brief Optional title
+      JsonSchemaStringId title {0};
+
+      ///@brief Json Schema type
+      JsonSchemaStringId type {0};
+
+      ///@brief C++ type to be generated
+      JsonSchemaStringId cpptype {0};
+
+      ///@brief HTML internal link target for its table
+      JsonSchemaStringId bookmark_target {0};
+
+      ///@brief Properties sorted by name
+      std::vector<JsonSchemaProperty> properties {};
+
+      ///@brief Index of its nested objects, in visiting order
+      std::vector<size_t> children {};
+    };
+
+    /// @brief Wall time and memory of a single phase of the generator.
+    struct JsonSchemaPhase {
+
+      ///@brief for example "parse" or "cpp filter"
+      std::string name {};
+
+      ///@brief wall time
+      double milliseconds {0};
+
+      ///@brief allocations made meanwhile, 0 if unknown
+      size_t allocations {0};
+
+      ///@brief bytes requested by those allocations, whatever they were freed or not
+      size_t bytes {0};
+
+      ///@brief peak resident set size when it ended, since JsonSchemaStats::resetPeak, in KiB, 0 if unknown
+      size_t peak {0};
+    };
+
+    /// @brief Phases of loading, filtering and writing a schema, in the order they ran.
+    /// @remark Allocations are only known through 'probe': the library cannot count them by itself.
+    /// @remark A serial traversal is a single "filter" phase, followed by a "<name> filter" phase per filter: its share of it.
+    /// @remark Peaks are the ones of the whole process since resetPeak(), to be called once per run outside any phase:
+    /// phases neither reset nor change the allocator state or the resident pages.
+    struct JsonSchemaStats {
+
+      ///@brief Allocations made by the process so far
+      struct Counters {
+	size_t allocations {0};
+	size_t bytes {0};
+      };
+
+      ///@brief if set, allocations made so far
+      Counters (*probe)() {nullptr};
+
+      ///@brief finished phases
+      std::vector<JsonSchemaPhase> phases {};
+
+      ///@brief a phase begins, phases are not nested
+      void start(std::string name);
+
+      ///@brief the phase begun by start ends
+      void stop();
+
+      ///@brief a line per phase, after a header line
+      std::string text() const;
+
+      ///@brief an array of objects, a phase per object
+      std::string json() const;
+
+      ///@brief peak resident memory measured from now on, if the system is able to forget the previous one
+      /// @remark Not done by any phase: on Linux, it writes /proc/self/clear_refs
+      static void resetPeak();
+
+      ///@brief peak resident memory in KiB, 0 if unknown
+      static size_t peak();
+
+      ///@brief phase begun by start
+      JsonSchemaPhase running {};
+
+      ///@brief steady clock nanoseconds when the running phase began
+      std::int64_t since {0};
+
+      ///@brief counters when the running phase began
+      Counters before {};
+    };
+
+    /// @brief How a json schema is loaded and compiled.
+    struct JsonSchemaOptions {
+
+      ///@brief Threads to compile sibling subtrees in parallel
+      /// @remark 0 or 1 means serial; the result is the same anyway
+      unsigned threads {0};
+
+      ///@brief Memory map the file and parse it in place, without copying it or its strings
+      /// @remark Falls back to reading a copy of the file if it cannot be mapped
+      bool insitu {true};
+
+      ///@brief Neither document nor objects: applyFilters reads the file again as a stream of SAX events
+      /// @remark Memory depends on schema depth, not size. Objects are filtered as soon as they are closed,
+      /// so nested ones come first, in document order.
+      /// @remark Filtering fails if a filter has no sink or the schema has any "$ref", which would not be followed.
+      bool stream {false};
+
+      ///@brief if set, reading, parsing and compiling are measured there
+      JsonSchemaStats* stats {nullptr};
+    };
+
+    /// @brief Memory for the documents of several schemas, loaded one after the other.
+    /// @remark Once reset, a single buffer as large as the largest document so far is reused: no allocation per chunk.
+    /// @remark Every schema loaded with it must be destroyed before reset() or its own destruction.
+    struct JsonSchemaArena {
+
+      ///@brief buffer of 'capacity' bytes, grown by reset() if needed
+      explicit JsonSchemaArena(size_t capacity = 64 * 1024);
+
+      ///@brief release buffer and chunks
+      ~JsonSchemaArena();
+
+      JsonSchemaArena(const JsonSchemaArena&) = delete;
+      JsonSchemaArena& operator=(const JsonSchemaArena&) = delete;
+
+      ///@brief forget every document, keeping as much memory as they needed
+      void reset();
+
+      ///@brief bytes available before the next chunk allocation
+      size_t capacity() const;
+
+      ///@brief Internal rapidjson::MemoryPoolAllocator: void to avoid rapidjson dependencies
+      void* allocator_ptr {nullptr};
+
+      ///@brief reused from one document to the next
+      std::unique_ptr<char[]> buffer {};
+
+      ///@brief bytes of buffer
+      size_t buffer_size {0};
+    };
+
     /// @brief minimum wrapper for json schemas read by rapidjson
     struct JsonSchema {
 
@@ -35,8 +259,15 @@ namespace boilerplateCodeDoc {
 
       /// @brief Process external json file.
       /// @param [in] filename to process.
+      /// @param [in] options to load and compile it.
       /// @return if success returns true, otherwise false.
-      explicit JsonSchema(std::string filename);
+      explicit JsonSchema(std::string filename, JsonSchemaOptions options = {});
+
+      /// @brief Process external json file into a caller owned arena.
+      /// @param [in] filename to process.
+      /// @param [in,out] arena where the document is allocated, it must outlive this schema.
+      /// @param [in] options to load and compile it.
+      JsonSchema(std::string filename, JsonSchemaArena& arena, JsonSchemaOptions options = {});
 
       /// @brief Error code
       ParseErrorCode error {ParseErrorCode::OK};
@@ -47,6 +278,18 @@ namespace boilerplateCodeDoc {
       ///@brief Internal pointer: void to avoid rapidjson dependencies
       void* document_ptr {nullptr};
 
+      ///@brief Memory mapped file the document strings point into, if parsed in place
+      void* mapping_ptr {nullptr};
+
+      ///@brief Size of the memory mapped file, terminator included
+      size_t mapping_size {0};
+
+      ///@brief Only root members were loaded: objects are compiled while filtering
+      bool streaming {false};
+
+      ///@brief Json Schema file, read again when streaming
+      std::string filename {};
+
       ///@brief Json Schema title
       ///@remark for debugging
       std::string title {};
@@ -70,8 +313,150 @@ namespace boilerplateCodeDoc {
       /// @brief Expected global data structure name to generate getters/setters.
       /// @remark Although needed by another class, it's very handy to grab that piece of info here
       std::string cpp_global_data_name {};
+
+      /// @brief Schema objects with properties, in the order filters must visit them.
+      /// @remark Built only once while loading, so every filter reads it instead of walking the document again.
+      std::vector<JsonSchemaObject> objects {};
+
+      /// @brief Strings referenced by the objects and their properties.
+      JsonSchemaStrings strings {};
+
+    private:
+
+      // both public constructors
+      JsonSchema(std::string filename, JsonSchemaArena* arena, JsonSchemaOptions options);
+    };
+
+
+    /// @brief Output of a filter for a single schema object.
+    struct JsonSchemaSegment {
+
+      ///@brief output, joined according to JsonSchemaFilter::prepend
+      std::string text {};
+    };
+
+    /// @brief When the generator was compiled: the same version built again gets another stamp.
+    const char* buildStamp();
+
+    /// @brief 64 bits FNV-1a hash.
+    /// @param [in] seed previous hash, to chain several pieces of data.
+    uint64_t hash64(std::string_view bytes, uint64_t seed = 14695981039346656037ull);
+
+    /// @brief Segments kept from one run to the next, by hash of the object and the filter parameters they come from.
+    /// @remark Only objects that changed since the previous run are filtered again; the rest are spliced as they were.
+    struct JsonSchemaFragments {
+
+      ///@brief segments of the previous run, looked up while filtering
+      std::unordered_map<uint64_t, JsonSchemaSegment> previous {};
+
+      ///@brief segments of the last run, to be looked up by the next one
+      std::unordered_map<uint64_t, JsonSchemaSegment> current {};
+
+      ///@brief objects of the last run taken from 'previous'
+      size_t reused {0};
+
+      ///@brief filter parameters and schema root members of the last run, mixed into every key
+      uint64_t salt {0};
+
+      ///@brief the last run becomes the previous one
+      void next();
+
+      ///@brief 'previous' from a file written by save
+      ///@return false if there is no such file or it is not a fragments file: nothing to reuse
+      bool load(const std::string& filename);
+
+      ///@brief 'current' into a file
+      bool save(const std::string& filename) const;
+    };
+
+    /// @brief Where a filter output goes, piece by piece, instead of being kept as a whole in 'filtered'.
+    struct JsonSchemaSink {
+
+      ///@brief typical virtual destructor just in case
+      virtual ~JsonSchemaSink() = default;
+
+      ///@brief append several pieces, in order; they might be buffered
+      ///@return false if anything could not be written
+      virtual bool write(const std::string_view* pieces, size_t count) = 0;
+
+      ///@brief append a single piece
+      bool write(std::string_view piece) { return write(&piece, 1); }
+
+      ///@brief whatever is buffered reaches its destination
+      virtual bool flush() { return true; }
+    };
+
+    /// @brief File descriptor: small pieces are gathered into a buffer, large ones go with it in a single writev.
+    /// @remark The descriptor is neither opened nor closed here.
+    struct JsonSchemaFdSink final: public JsonSchemaSink {
+
+      ///@brief bytes buffered before a system call
+      static constexpr size_t CAPACITY {64 * 1024};
+
+      ///@brief pieces from this size on are never copied
+      static constexpr size_t LARGE {4 * 1024};
+
+      explicit JsonSchemaFdSink(int fd_) : fd{fd_} {}
+
+      ///@brief flush, errors ignored
+      ~JsonSchemaFdSink() override { flush(); }
+
+      using JsonSchemaSink::write;
+      bool write(const std::string_view* pieces, size_t count) override;
+      bool flush() override;
+
+      ///@brief destination
+      int fd {-1};
+
+      ///@brief small pieces not written yet
+      std::string buffer {};
+
+      ///@brief system calls made, for statistics
+      size_t calls {0};
+    };
+
+    /// @brief C stream, buffered by the C library itself.
+    struct JsonSchemaFileSink final: public JsonSchemaSink {
+      explicit JsonSchemaFileSink(std::FILE* file_) : file{file_} {}
+      using JsonSchemaSink::write;
+      bool write(const std::string_view* pieces, size_t count) override;
+      bool flush() override;
+
+      ///@brief destination, neither opened nor closed here
+      std::FILE* file {nullptr};
     };
 
+    /// @brief C++ stream.
+    struct JsonSchemaStreamSink final: public JsonSchemaSink {
+      explicit JsonSchemaStreamSink(std::ostream& stream_) : stream{&stream_} {}
+      using JsonSchemaSink::write;
+      bool write(const std::string_view* pieces, size_t count) override;
+      bool flush() override;
+
+      ///@brief destination
+      std::ostream* stream {nullptr};
+    };
+
+    /// @brief Memory: everything appended to a single string.
+    struct JsonSchemaBufferSink final: public JsonSchemaSink {
+      using JsonSchemaSink::write;
+      bool write(const std::string_view* pieces, size_t count) override;
+
+      ///@brief destination
+      std::string buffer {};
+    };
+
+    /// @brief Nothing kept but the hash64 of the output and its size, for example to find out whether it changed.
+    struct JsonSchemaHashSink final: public JsonSchemaSink {
+      using JsonSchemaSink::write;
+      bool write(const std::string_view* pieces, size_t count) override;
+
+      ///@brief of everything written so far
+      uint64_t hash {hash64({})};
+
+      ///@brief bytes written so far
+      size_t size {0};
+    };
 
     /// @brief Basic interface to process Json file similar.
     struct JsonSchemaFilter {
@@ -91,11 +476,53 @@ namespace boilerplateCodeDoc {
 
       ///@brief rapidjosn filter
       ///@remarks void to avoid rapidjson dependencies
-      virtual bool operator()(const JsonSchema& jsonSchema) = 0;
+      ///@remark same as applyFilters with only this filter
+      virtual bool operator()(const JsonSchema& jsonSchema);
+
+      ///@brief get ready before the first object
+      ///@return false if there is nothing to filter
+      ///@remark overrides must call it
+      virtual bool begin(const JsonSchema& jsonSchema);
+
+      ///@brief filter one object of the intermediate representation
+      ///@remark const: objects might be filtered in parallel
+      virtual void filterObject(const JsonSchemaObject& object, JsonSchemaSegment& segment) const = 0;
+
+      ///@brief wrap up after the last object: header + filtered + segments + footer
+      ///@remark into 'sink' if set, otherwise into 'filtered'
+      virtual bool end(const JsonSchema& jsonSchema);
+
+      ///@brief short name of its output, for example to name its phases
+      virtual const char* name() const { return "filter"; }
+
+      ///@brief emission options changing its output, hashed along with header, footer and extra by caches
+      virtual std::string options() const { return std::string{}; }
 
       ///@brief result of that filter
       std::string filtered {};
 
+      ///@brief if set, output is written there, piece by piece, instead of being kept in 'filtered'
+      /// @remark required while streaming: every object is written as soon as it is filtered; end() flushes it
+      /// @remark a serial traversal writes every object as soon as it is filtered too, unless it has to 'prepend' it
+      JsonSchemaSink* sink {nullptr};
+
+      ///@brief header and segments already written into 'sink', object by object, between begin and end
+      bool streamed {false};
+
+      ///@brief output fragments, one per object, joined into 'filtered' only once by end()
+      std::vector<JsonSchemaSegment> segments {};
+
+      ///@brief if set, objects unchanged since the previous run are not filtered again
+      /// @remark filterObject must only depend on the object, the filter parameters and the schema root members
+      JsonSchemaFragments* fragments {nullptr};
+
+      ///@brief strings of the schema being filtered, only between begin and end
+      const JsonSchemaStrings* strings {nullptr};
+
+      ///@brief segments are joined from last to first
+      /// @remark nested C++ types must be declared before being used; streamed objects already come that way
+      bool prepend {false};
+
       ///@brief preambule
       /// @remark to override
       std::string header {};
@@ -175,8 +602,14 @@ namespace boilerplateCodeDoc {
       JsonSchema2HTML(std::string extra_ = CSS_CLASS, std::string header_ = HEADER, std::string footer_ = FOOTER) :
 	      JsonSchemaFilter(extra_, header_, footer_) {}
 
+      ///@brief get css class
+      bool begin(const JsonSchema& jsonSchema) override;
+
+      ///@brief "html"
+      const char* name() const override { return "html"; }
+
       ///@brief filter to apply
-      bool operator()(const JsonSchema& jsonSchema) override;
+      void filterObject(const JsonSchemaObject& object, JsonSchemaSegment& segment) const override;
 
       ///@brief css class to be added to generated tables
       std::string css_class {};
@@ -210,10 +643,30 @@ namespace boilerplateCodeDoc {
 
       ///@brief simplest constructor
       JsonSchema2H(std::string extra_ = NAMESPACE, std::string header_ = HEADER, std::string footer_ = FOOTER) :
-	      JsonSchemaFilter(extra_, header_, footer_) {}
+	      JsonSchemaFilter(extra_, header_, footer_) { prepend = true; }
+
+      ///@brief complete header and footer
+      bool begin(const JsonSchema& jsonSchema) override;
+
+      ///@brief "h"
+      const char* name() const override { return "h"; }
 
       ///@brief filter to apply
-      bool operator()(const JsonSchema& jsonSchema) override;
+      void filterObject(const JsonSchemaObject& object, JsonSchemaSegment& segment) const override;
+
+      ///@brief "views", "pmr" or both, comma separated
+      std::string options() const override { return std::string{views ? "views" : ""} + (views && pmr ? "," : "") + (pmr ? "pmr" : ""); }
+
+      ///@brief namespace to isolate generated code
+      std::string namespace_id {};
+
+      ///@brief also emit a view flavour of every struct, in a nested 'view' namespace
+      /// @remark std::string members become std::string_view, pointing into a buffer parsed in place
+      bool views {false};
+
+      ///@brief std::pmr::string and std::pmr::vector members, allocator-aware structs
+      /// @remark a whole Data tree can live in a single std::pmr::monotonic_buffer_resource; the generated cpp reads it unchanged
+      bool pmr {false};
     };
 
     /// @brief Specific handler to generate cpp file.
@@ -239,12 +692,87 @@ namespace boilerplateCodeDoc {
 
       ///@brief simplest constructor
       JsonSchema2CPP(std::string extra_ = NAMESPACE, std::string header_ = HEADER, std::string footer_ = FOOTER) :
-	      JsonSchemaFilter(extra_, header_, footer_) {}
+	      JsonSchemaFilter(extra_, header_, footer_) { prepend = true; }
+
+      ///@brief complete header and getter/setter prototypes
+      bool begin(const JsonSchema& jsonSchema) override;
+
+      ///@brief "cpp"
+      const char* name() const override { return "cpp"; }
 
       ///@brief filter to apply
-      bool operator()(const JsonSchema& jsonSchema) override;
+      /// @remark every struct gets its SAX reader: rapidjson::Reader events decode a request straight into it
+      /// @remark and its writer: pre-escaped key literals, output reserved from a size estimate per struct
+      void filterObject(const JsonSchemaObject& object, JsonSchemaSegment& segment) const override;
+
+      ///@brief add getter and setter after the standard footer
+      bool end(const JsonSchema& jsonSchema) override;
+
+      ///@brief getter body, reading Data with its SAX reader
+      std::string getter_body {};
+
+      ///@brief setter body, writing the json text of Data
+      std::string setter_body {};
+
+      ///@brief "views" if the view flavour is read too
+      std::string options() const override { return views ? "views" : ""; }
+
+      ///@brief namespace of the structs to be read
+      std::string namespace_id {};
+
+      ///@brief also read the view flavour of every struct, as JsonSchema2H declares it
+      bool views {false};
     };
 
+    /// @brief Shape of a synthetic schema, for scale and stress tests.
+    /// @remark Same shape, same schema: leaf types and "not implemented" ones are drawn from a seeded generator.
+    struct JsonSchemaSynthetic {
+
+      ///@brief levels of nested objects, 1 means only the root object
+      /// @remark 0 means no object at all: valid json, but not a schema JsonSchema accepts
+      size_t depth {3};
+
+      ///@brief leaf properties of every object
+      size_t breadth {10};
+
+      ///@brief nested properties of every object but the deepest ones, alternating objects and arrays of objects
+      size_t fanout {2};
+
+      ///@brief characters of every leaf description, 0 means no description
+      size_t description_length {32};
+
+      ///@brief percentage of leaves whose metainfo is "not implemented"
+      unsigned not_implemented {10};
+
+      ///@brief alternatives of every "oneOf", 0 means a plain "required" instead
+      size_t one_of {2};
+
+      ///@brief seed of the pseudo random generator
+      uint32_t seed {1};
+
+      ///@brief properties of the whole schema, nested ones included
+      size_t properties() const;
+
+      ///@brief objects of the whole schema, root included
+      size_t objects() const;
+    };
+
+    /// @brief Json Schema in this project dialect: cpptype, jsontype, metainfo, scope, properties, items, required and oneOf.
+    std::string syntheticSchema(const JsonSchemaSynthetic& shape);
+
+    /// @brief Name declared by a C++ type, for example "Data" from "struct Data".
+    /// @return empty if no name is found.
+    std::string cppTypeName(std::string_view cpptype);
+
+    /// @brief Apply several filters in a single traversal of the schema.
+    /// @param [in] jsonSchema already loaded.
+    /// @param [in,out] filters whose callbacks are invoked in turn for every object.
+    /// @param [in] threads to filter sibling subtrees in parallel, 0 or 1 means serial.
+    /// @param [in,out] stats if set, filtering and joining are measured there; then filters run one after the other.
+    /// @return true if all the filters succeeded, otherwise false.
+    /// @remark output is byte-identical whatever the number of threads.
+    bool applyFilters(const JsonSchema& jsonSchema, const std::vector<JsonSchemaFilter*>& filters, unsigned threads = 0, JsonSchemaStats* stats = nullptr);
+
 } // namespace
 
 #endif // header
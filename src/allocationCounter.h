@@ -0,0 +1,112 @@
+/** @file allocationCounter.h
+ * @brief Process wide allocation counters shared by the tool and the benchmark.
+ *
+ * @remark Internal header: not installed with boilerplateCodeDoc.h
+ * @remark It replaces the allocator, so it must be included by a single translation unit of an executable.
+ * @remark Nothing is counted until allocationCounting(true): otherwise an allocation only pays a relaxed load.
+ * @remark With glibc malloc, calloc, realloc, memalign, posix_memalign and aligned_alloc are counted;
+ * valloc, pvalloc and memory obtained with mmap or sbrk directly are not.
+ * Elsewhere only operator new (and operator new[] through it) is: rapidjson and aligned operator new are missing.
+ * Frees are never counted.
+ *
+ */
+
+#ifndef BOILERPLATECODEDOC_ALLOCATIONCOUNTER_H
+#define BOILERPLATECODEDOC_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "boilerplateCodeDoc.h"
+
+namespace boilerplateCodeDoc {
+
+    namespace allocationCounter {
+
+      // relaxed: only read between phases
+      static std::atomic<bool> counting {false};
+      static std::atomic<size_t> allocations {0};
+      static std::atomic<size_t> allocated {0};
+
+      inline void count(size_t size) noexcept
+      {
+	if( not counting.load(std::memory_order_relaxed) ) { return; }
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated.fetch_add(size, std::memory_order_relaxed);
+      }
+    }
+
+    ///@brief Start or stop counting allocations
+    inline void allocationCounting(bool on)
+    {
+      allocationCounter::counting.store(on, std::memory_order_relaxed);
+    }
+
+    ///@brief Allocations counted so far, a JsonSchemaStats probe
+    inline JsonSchemaStats::Counters allocationCounters()
+    {
+      return JsonSchemaStats::Counters{allocationCounter::allocations.load(std::memory_order_relaxed),
+				       allocationCounter::allocated.load(std::memory_order_relaxed)};
+    }
+}
+
+#if defined(__GLIBC__)
+// C allocator itself: rapidjson pools and operator new are counted alike
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+   boilerplateCodeDoc::allocationCounter::count(size);
+   return __libc_malloc(size);
+}
+void* calloc(size_t count, size_t size) noexcept
+{
+   boilerplateCodeDoc::allocationCounter::count(count * size);
+   return __libc_calloc(count, size);
+}
+void* realloc(void* pointer, size_t size) noexcept
+{
+   boilerplateCodeDoc::allocationCounter::count(size);
+   return __libc_realloc(pointer, size);
+}
+void* memalign(size_t alignment, size_t size) noexcept
+{
+   boilerplateCodeDoc::allocationCounter::count(size);
+   return __libc_memalign(alignment, size);
+}
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+   boilerplateCodeDoc::allocationCounter::count(size);
+   return __libc_memalign(alignment, size);
+}
+int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+{
+   if( alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0 ) { return EINVAL; }
+   boilerplateCodeDoc::allocationCounter::count(size);
+   void* result {__libc_memalign(alignment, size)};
+   if( result == nullptr ) { return ENOMEM; }
+   *pointer = result;
+   return 0;
+}
+}
+#else
+void* operator new(size_t size)
+{
+   boilerplateCodeDoc::allocationCounter::count(size);
+   if( void* pointer = std::malloc(size ? size : 1) ) { return pointer; }
+   throw std::bad_alloc{};
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+#endif
+
+#endif // BOILERPLATECODEDOC_ALLOCATIONCOUNTER_H
@@ -1,16 +1,36 @@
 #include <boost/hana.hpp>
 #include <string>
 #include <fstream>
+#include <ostream>
+#include <cstdio>
 #include <vector>
 #include <utility>
 #include <map>
 #include <set>
-#include <regex>
 #include <functional>
+#include <algorithm>
+#include <mutex>
+#include <cstring>
+#include <typeinfo>
+#include <array>
+#include <chrono>
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/pointer.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/filereadstream.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#endif
 
 // debug
 #include <iostream>
@@ -18,6 +38,7 @@
 // automatically generate version info
 #include "version.h"
 #include "boilerplateCodeDoc.h"
+#include "threadPool.h"
 
 /****************************************************************************************/
 /****************************************************************************************/
@@ -35,18 +56,116 @@ static inline std::string to_string(const boilerplateCodeDoc::ParseErrorCode& er
 		case boilerplateCodeDoc::ParseErrorCode::UNEXPECTED_ERROR_PROCESSING_SCHEMA_JSON_FILE: return "UNEXPECTED_ERROR_PROCESSING_SCHEMA_JSON_FILE";
 		case boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON: return "ERROR_PARSING_SCHEMA_JSON";
 		case boilerplateCodeDoc::ParseErrorCode::UNABLE_OPEN_FILE: return "UNABLE_OPEN_FILE";
+		case boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT: return "ERROR_FILTERING_DOCUMENT";
 	    }
 }
 
+// phases are measured only if asked for
+static inline void startPhase(boilerplateCodeDoc::JsonSchemaStats* stats, std::string name);
+static inline void stopPhase(boilerplateCodeDoc::JsonSchemaStats* stats);
+
+// root members only, objects are compiled while streaming
+static void prescan(const std::string& filename, boilerplateCodeDoc::JsonSchema& jsonSchema);
+
+// intermediate representation shared by all the filters
+static void compile(const rapidjson::Value& document, unsigned threads,
+                    std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, boilerplateCodeDoc::JsonSchemaStrings& strings);
+
+// private copy on write mapping with at least one trailing zero: ParseInsitu writes into it and needs a terminator
+static bool mapFile(const std::string& filename, void*& mapping, size_t& size)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	int fd {::open(filename.c_str(), O_RDONLY)};
+	if( fd < 0 ) { return false; }
+
+	struct stat info {};
+	if( ::fstat(fd, &info) != 0 || info.st_size <= 0 ) { ::close(fd); return false; }
+	size_t length {static_cast<size_t>(info.st_size)};
+
+	// zero filled room first, then the file on top of it: the rest of its last page is zero as well
+	size_t page {static_cast<size_t>(::sysconf(_SC_PAGESIZE))};
+	size_t total {(length / page + 1) * page};
+	void* reserved {::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+	if( reserved == MAP_FAILED ) { ::close(fd); return false; }
+	void* file {::mmap(reserved, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0)};
+	::close(fd);
+	if( file == MAP_FAILED ) { ::munmap(reserved, total); return false; }
+	::madvise(file, length, MADV_SEQUENTIAL);
+
+	mapping = reserved;
+	size = total;
+	return true;
+#else
+	return false;
+#endif
+}
+
+static void unmapFile(void*& mapping, size_t& size)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	if( mapping ) { ::munmap(mapping, size); }
+#endif
+	mapping = nullptr;
+	size = 0;
+}
+
 boilerplateCodeDoc::JsonSchema::~JsonSchema()
 {
 	if(document_ptr) {
 		delete reinterpret_cast<rapidjson::Document*>(document_ptr);
 		document_ptr = nullptr;
 	}
+
+	// document strings might point into it
+	unmapFile(mapping_ptr, mapping_size);
+}
+
+using ArenaAllocator = rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>;
+static constexpr size_t ARENA_GRANULARITY {64 * 1024};
+
+boilerplateCodeDoc::JsonSchemaArena::JsonSchemaArena(size_t capacity)
+{
+	buffer_size = std::max(capacity, size_t{1024}); // room for the chunk header anyway
+	buffer.reset(new char[buffer_size]);
+	allocator_ptr = reinterpret_cast<void*>(new ArenaAllocator{buffer.get(), buffer_size});
+}
+
+boilerplateCodeDoc::JsonSchemaArena::~JsonSchemaArena()
+{
+	delete reinterpret_cast<ArenaAllocator*>(allocator_ptr);
+}
+
+void boilerplateCodeDoc::JsonSchemaArena::reset()
+{
+	// the buffer alone is a bit less than its size: its chunk header is not counted
+	ArenaAllocator* allocator {reinterpret_cast<ArenaAllocator*>(allocator_ptr)};
+	size_t used {allocator->Capacity()};
+	if( used < buffer_size ) {
+		allocator->Clear();
+		return;
+	}
+
+	// extra chunks were needed: a single buffer as large as all of them together
+	delete allocator;
+	allocator_ptr = nullptr;
+	buffer.reset();
+	buffer_size = (used / ARENA_GRANULARITY + 1) * ARENA_GRANULARITY;
+	buffer.reset(new char[buffer_size]);
+	allocator_ptr = reinterpret_cast<void*>(new ArenaAllocator{buffer.get(), buffer_size});
+}
+
+size_t boilerplateCodeDoc::JsonSchemaArena::capacity() const
+{
+	return reinterpret_cast<const ArenaAllocator*>(allocator_ptr)->Capacity();
 }
 
-boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename)
+boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename, boilerplateCodeDoc::JsonSchemaOptions options)
+	: JsonSchema(std::move(filename), nullptr, options) {}
+
+boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename, boilerplateCodeDoc::JsonSchemaArena& arena, boilerplateCodeDoc::JsonSchemaOptions options)
+	: JsonSchema(std::move(filename), &arena, options) {}
+
+boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename, boilerplateCodeDoc::JsonSchemaArena* arena, boilerplateCodeDoc::JsonSchemaOptions options)
 {
 
 	if( filename.empty() ) {
@@ -57,26 +176,51 @@ boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename)
 
 	try {
 
-		std::ifstream json{filename};
-		if( json.is_open() ) {
+		// no document at all
+		if( options.stream ) {
+			startPhase(options.stats, "prescan");
+			prescan(filename, *this);
+			stopPhase(options.stats);
+			return;
+		}
+
+		// parsed in place: neither the file nor its strings are copied
+		startPhase(options.stats, "read");
+		bool mapped { options.insitu && mapFile(filename, mapping_ptr, mapping_size) };
+
+		std::ifstream json{};
+		if( not mapped ) { json.open(filename); }
+		if( mapped || json.is_open() ) {
 
 		     // temporary var
 		     std::string contents;
+		     if( not mapped ) {
 
-		     // allocate all the memory up front
-		     json.seekg(0, std::ios::end);
-		     contents.reserve(json.tellg());
-		     json.seekg(0, std::ios::beg);
+			 // allocate all the memory up front
+			 json.seekg(0, std::ios::end);
+			 contents.reserve(json.tellg());
+			 json.seekg(0, std::ios::beg);
 
-		     // read data
-		     contents.assign((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+			 // read data
+			 contents.assign((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+		     }
+		     stopPhase(options.stats);
 
 		     // get json ready to process
-		     rapidjson::Document* temp = new rapidjson::Document;
+		     rapidjson::Document* temp = arena ? new rapidjson::Document{reinterpret_cast<ArenaAllocator*>(arena->allocator_ptr)}
+						       : new rapidjson::Document;
 		     rapidjson::Document& document {*temp};
 		     document_ptr = reinterpret_cast<void*>(temp);
 
-		     rapidjson::ParseResult ok = document.Parse(contents.c_str());
+		     startPhase(options.stats, "parse");
+		     rapidjson::ParseResult ok {};
+		     if( mapped ) {
+			 ok = document.ParseInsitu(reinterpret_cast<char*>(mapping_ptr));
+		     } else {
+			 ok = document.Parse(contents.c_str());
+		     }
+		     stopPhase(options.stats);
+
 		     if( not ok ) {
 			 error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
 			 message = to_string(error);
@@ -123,18 +267,14 @@ boilerplateCodeDoc::JsonSchema::JsonSchema(std::string filename)
 				      cpp_filename = document["cppFileName"].GetString();
 			     }
                  if( document.HasMember("cpptype") ) {
-                      std::string cpptype {document["cpptype"].GetString()};
-                      if(not cpptype.empty()) {
-					static const std::regex name{"^.* (.*)$"};
-					std::smatch match;
-                    if(std::regex_search(cpptype, match, name)) {
-						if(match.size() > 0) {
-							cpp_global_data_name = match[match.size() - 1];
-						}
-					}
-				      }
+				      cpp_global_data_name = boilerplateCodeDoc::cppTypeName(document["cpptype"].GetString());
 			     }
 
+			     // compiled only once, whatever the number of filters to apply
+			     startPhase(options.stats, "compile");
+			     compile(document, options.threads, objects, strings);
+			     stopPhase(options.stats);
+
 			     error = boilerplateCodeDoc::ParseErrorCode::OK;
 			     message = to_string(error);
 
@@ -159,47 +299,237 @@ static inline bool ignore(const std::string& name, const std::set<std::string>&
 }
 using Required = std::vector<std::string>;
 using OneOf = std::vector<Required>;
-struct Property {
-    bool required {false};
-    std::string element {};
-    std::string scope {};
-    std::string name {};
-    std::string type {};
-    std::string description {};
-    std::string title {};
-    std::string parentTitle {};
-    std::string parentType {};
-    std::string cpptype {};
-    std::string jsontype {};
-    std::string parentcpptype {};
-    std::string metainfo {};
-    std::string bookmark_source {};
-    std::string bookmark_target {};
-    Property(bool req, std::string elm, std::string sco, std::string nam, std::string typ, std::string ptyp, std::string des, std::string tit,
-         std::string par, std::string met, std::string jst, std::string pm, std::string inf, std::string bs, std::string bt)
-	: required{req}, element{std::move(elm)},
-	  scope{std::move(sco)}, name{std::move(nam)}, type{std::move(typ)}, parentType{std::move(ptyp)},
-	  description{std::move(des)}, title{std::move(tit)}, parentTitle{std::move(par)},
-      cpptype{std::move(met)}, jsontype{std::move(jst)}, parentcpptype{std::move(pm)}, metainfo{std::move(inf)},
-	  bookmark_source{std::move(bs)}, bookmark_target{std::move(bt)} {}
+
+boilerplateCodeDoc::JsonSchemaStrings::JsonSchemaStrings()
+{
+    views.emplace_back(); // handle 0
+}
+
+void boilerplateCodeDoc::JsonSchemaStrings::clear()
+{
+    // the first block is kept for the next values
+    if( blocks.size() > 1 ) { blocks.resize(1); }
+    used = blocks.empty() ? BLOCK_SIZE : 0;
+    views.resize(1);
+    lookup.clear();
+}
+
+boilerplateCodeDoc::JsonSchemaStringId boilerplateCodeDoc::JsonSchemaStrings::intern(std::string_view value)
+{
+    if( value.empty() ) { return 0; }
+
+    auto found = lookup.find(value);
+    if( found != lookup.end() ) { return found->second; }
+
+    // no allocation at all until the current block is full
+    if( used + value.size() > BLOCK_SIZE ) {
+	blocks.emplace_back(new char[std::max(BLOCK_SIZE, value.size())]);
+	used = 0;
+    }
+    char* stored {blocks.back().get() + used};
+    std::memcpy(stored, value.data(), value.size());
+    used += value.size();
+
+    boilerplateCodeDoc::JsonSchemaStringId id {static_cast<boilerplateCodeDoc::JsonSchemaStringId>(views.size())};
+    views.emplace_back(stored, value.size());
+    lookup.emplace(views.back(), id);
+    return id;
+}
+
+static inline std::string_view getView(const rapidjson::Value& value)
+{
+    return value.IsString() ? std::string_view{value.GetString(), value.GetStringLength()} : std::string_view{};
+}
+
+// shared while compiling, serialized only when sibling subtrees are compiled in parallel
+struct Context {
+    const rapidjson::Value& document;
+    boilerplateCodeDoc::JsonSchemaStrings& strings;
+    std::mutex* mutex {nullptr};
+    std::map<std::string, const rapidjson::Value*, std::less<>> targets {}; // resolved "$ref", keyed by target pointer
+
+    boilerplateCodeDoc::JsonSchemaStringId intern(std::string_view value) {
+	if( not mutex ) { return strings.intern(value); }
+	std::lock_guard<std::mutex> lock {*mutex};
+	return strings.intern(value);
+    }
+
+    // views are stable, only the table of views might move
+    std::string_view view(boilerplateCodeDoc::JsonSchemaStringId id) {
+	if( not mutex ) { return strings[id]; }
+	std::lock_guard<std::mutex> lock {*mutex};
+	return strings[id];
+    }
+
+    // local references only, for example "#/definitions/Deal"; every target pointer is parsed only once
+    const rapidjson::Value* resolve(std::string_view ref) {
+	if( ref.empty() || ref.front() != '#' ) { return nullptr; }
+	std::unique_lock<std::mutex> lock {};
+	if( mutex ) { lock = std::unique_lock<std::mutex>{*mutex}; }
+
+	auto found = targets.find(ref);
+	if( found != targets.end() ) { return found->second; }
+
+	const rapidjson::Value* target {nullptr};
+	rapidjson::Pointer pointer {ref.data(), ref.size()};
+	if( pointer.IsValid() ) { target = pointer.Get(document); }
+	if( target && not target->IsObject() ) { target = nullptr; }
+	targets.emplace(std::string{ref}, target);
+	return target;
+    }
+
+    // schema made of a "$ref"
+    const rapidjson::Value* resolve(const rapidjson::Value& schema, std::string_view& ref) {
+	if( not schema.IsObject() ) { return nullptr; }
+	auto found = schema.FindMember("$ref");
+	if( found == schema.MemberEnd() ) { return nullptr; }
+	ref = getView(found->value);
+	return resolve(ref);
+    }
 };
-using Properties = std::map<std::string, Property>;
 
-static bool getString(const rapidjson::Document& document, const std::string& element, const std::string& prefix, const std::string& name, const std::string& suffix, std::string& result)
+// property being compiled: its resolved info plus where to go next
+struct Candidate {
+    boilerplateCodeDoc::JsonSchemaProperty property {};
+    const rapidjson::Value* schema {nullptr}; // schema object of the property
+    bool nested {false}; // object or array
+    std::string element {}; // its rapidjson::pointer like name
+    std::string ref {}; // target pointer of a referenced definition, compiled on its own
+};
+using Candidates = std::map<std::string_view, Candidate>; // keys are interned names
+
+static inline bool isKey(const rapidjson::Value& key, const char* name, rapidjson::SizeType length)
+{
+    return key.GetStringLength() == length && 0 == std::memcmp(key.GetString(), name, length);
+}
+#define IS_KEY(key, name) isKey(key, name, sizeof(name) - 1)
+
+static inline void getString(const rapidjson::Value& value, Context& context, boilerplateCodeDoc::JsonSchemaStringId& result)
+{
+    if( value.IsString() ) { result = context.intern(getView(value)); }
+}
+
+static inline bool nested(std::string_view type)
+{
+    return "object" == type || "array" == type;
+}
+
+static bool implemented(std::string_view metainfo)
+{
+	if( metainfo.empty() ) { return true; } // empty candidates are supposedly implemented
+
+	// Look for exact matches
+	static std::set<std::string, std::less<>> NOT_IMPLEMENTED {"not implemented", "Not Implemented", "Not implemented", "NOT IMPLEMENTED"};
+	if( NOT_IMPLEMENTED.end() != NOT_IMPLEMENTED.find(metainfo) ) { return false; }
+
+	// Look for partial matches
+	for(const auto& s : NOT_IMPLEMENTED) { if( metainfo.find(s) != std::string_view::npos ) { return false; } }
+
+	// Implemented because we got any hint
+	return true;
+}
+
+// members shared by all the properties of the same object, resolved only once per object
+static bool getParent(const rapidjson::Value& object, Context& context, boilerplateCodeDoc::JsonSchemaObject& parent)
+{
+    if( parent.type ) { return true; } // already resolved by a previous group of properties
+
+    // a single pass over the members of the object
+    for(auto i = object.MemberBegin(); i != object.MemberEnd(); ++i) {
+        if( IS_KEY(i->name, "title") ) { getString(i->value, context, parent.title); }
+        else if( IS_KEY(i->name, "type") ) { getString(i->value, context, parent.type); }
+        else if( IS_KEY(i->name, "cpptype") ) { getString(i->value, context, parent.cpptype); }
+        else if( IS_KEY(i->name, "bookmarkTarget") ) { getString(i->value, context, parent.bookmark_target); }
+    }
+    if( parent.type && parent.cpptype ) { return true; } // required
+
+    parent.title = parent.type = parent.cpptype = parent.bookmark_target = 0;
+    return false;
+}
+
+static void getProperties(const rapidjson::Value& object, const rapidjson::Value& members, const std::string& nextElement,
+                          Context& context, boilerplateCodeDoc::JsonSchemaObject& parent, Candidates& candidates)
+{
+    if( not members.IsObject() ) { return; }
+    if( not getParent(object, context, parent) ) { return; }
+
+    for(auto j = members.MemberBegin(); j != members.MemberEnd(); ++j) {
+        const rapidjson::Value& schema {j->value};
+        if( not schema.IsObject() ) { continue; }
+
+        Candidate candidate {};
+        auto&& p {candidate.property}; // alias
+
+        // a referenced definition first, so any member of the property itself prevails
+        std::string_view ref {};
+        const rapidjson::Value* target {context.resolve(schema, ref)};
+
+        // a single pass over the members of the property
+        std::string_view type {}, metainfo {};
+        for(const rapidjson::Value* member : {target, &schema}) {
+            if( not member ) { continue; }
+            for(auto k = member->MemberBegin(); k != member->MemberEnd(); ++k) {
+                if( IS_KEY(k->name, "type") ) { type = getView(k->value); getString(k->value, context, p.type); }
+                else if( IS_KEY(k->name, "description") ) { getString(k->value, context, p.description); }
+                else if( IS_KEY(k->name, "title") ) { getString(k->value, context, p.title); }
+                else if( IS_KEY(k->name, "cpptype") ) { getString(k->value, context, p.cpptype); }
+                else if( IS_KEY(k->name, "jsontype") ) { getString(k->value, context, p.jsontype); }
+                else if( IS_KEY(k->name, "metainfo") ) { metainfo = getView(k->value); getString(k->value, context, p.metainfo); }
+                else if( IS_KEY(k->name, "scope") ) { getString(k->value, context, p.scope); }
+                else if( IS_KEY(k->name, "bookmarkSource") ) { getString(k->value, context, p.bookmark_source); }
+            }
+        }
+        if( not p.type || not p.cpptype || not p.jsontype ) { continue; } // required
+
+        // arrays of a referenced definition
+        if( not target ) {
+            auto items = schema.FindMember("items");
+            if( items != schema.MemberEnd() ) {
+                target = context.resolve(items->value, ref);
+                if( target && not p.title && target->HasMember("title") ) { getString((*target)["title"], context, p.title); }
+            }
+        }
+
+        std::string_view name {j->name.GetString(), j->name.GetStringLength()};
+        p.name = context.intern(name);
+        p.implemented = implemented(metainfo);
+        candidate.schema = target ? target : &schema;
+        candidate.nested = nested(type);
+        if( target ) {
+            candidate.element = ref;
+            candidate.ref = ref;
+        } else {
+            candidate.element.reserve(nextElement.size() + name.size());
+            candidate.element.append(nextElement).append(name);
+        }
+        candidates.emplace(context.view(p.name), std::move(candidate));
+    }
+}
+
+static void getRequired(const rapidjson::Value& array, Required& required)
+{
+    if( not array.IsArray() ) { return; }
+    for(auto&& j : array.GetArray()) {
+        if( j.IsString() ) { required.emplace_back(std::string{j.GetString(), j.GetStringLength()}); }
+    }
+}
+
+static void getOneOf(const rapidjson::Value& array, OneOf& oneOf)
 {
-  // Do nothing if there's nothing to do
-  std::string temp {element + prefix + name + suffix};
-  if( not rapidjson::Pointer(temp.c_str()).IsValid() ) { return false; }
-  const rapidjson::Value* pointer {rapidjson::Pointer(temp.c_str()).Get(document)};
-  if( not pointer ) { return false; }
-  if( pointer->IsNull() ) { return false; }
-  if( not pointer->IsString() ) { return false; }
-  result = pointer->GetString();
-  return true;
+    if( not array.IsArray() ) { return; }
+    for(auto&& j : array.GetArray()) {
+        if( not j.IsObject() || not j.HasMember("required") ) { continue; }
+        Required temp {};
+        getRequired(j["required"], temp);
+        oneOf.emplace_back(temp);
+    }
 }
 
-static void processProperties(const OneOf& oneOf, const Required& required, Properties& properties)
+static void processProperties(const OneOf& oneOf, const Required& required, Context& context,
+                              boilerplateCodeDoc::JsonSchemaObject& parent, Candidates& candidates)
 {
+	const boilerplateCodeDoc::JsonSchemaStringId REQUIRED {context.intern("required")};
+
 	if( oneOf.size() > 0 ) {
 
         // tricky part of selecting which "oneOf" array of requirements must be applied
@@ -207,12 +537,12 @@ static void processProperties(const OneOf& oneOf, const Required& required, Prop
         // therefore all posibilites will be mark as required and their 'descriptions' are supposed to provided extra details
 		for(const auto& o : oneOf) {
             for(const auto& r : o) {
-                 auto found = properties.find(r);
-                 if( found != properties.end() ) {
-		     found->second.required = true;
+                 auto found = candidates.find(r);
+                 if( found != candidates.end() ) {
+		     found->second.property.required = true;
 
 		     // if nothing was explicitly stated, "required" will be used as "scope"
-		     if( found->second.scope.empty() ) { found->second.scope = "required"; }
+		     if( not found->second.property.scope ) { found->second.property.scope = REQUIRED; }
 
 		 }
             }
@@ -220,391 +550,1904 @@ static void processProperties(const OneOf& oneOf, const Required& required, Prop
 
 	} else if ( required.size() > 0 ) {
 		for(const auto& r : required) {
-			auto found = properties.find(r);
-			if( found != properties.end() ) {
-				found->second.required = true;
+			auto found = candidates.find(r);
+			if( found != candidates.end() ) {
+				found->second.property.required = true;
 
 				// if nothing was explicitly stated, "required" will be used as "scope"
-				if( found->second.scope.empty() ) { found->second.scope = "required"; }
+				if( not found->second.property.scope ) { found->second.property.scope = REQUIRED; }
 			}
 		}
 	}
 
-	for(auto&& p : properties) {
+	const boilerplateCodeDoc::JsonSchemaStringId OPTIONAL {context.intern("optional")};
+	for(auto&& c : candidates) {
 
-		auto&& e {p.second}; //alias
+		auto&& e {c.second.property}; //alias
 
 		// by default "scope" will be "optional"
-		if( e.scope.empty() ) { e.scope = "optional"; }
+		if( not e.scope ) { e.scope = OPTIONAL; }
 
 		// get ready in a lazy way for HTML table internal links
-		if (e.type == "object" || e.type == "array" ) {
-			if( e.bookmark_source.empty() ) { e.bookmark_source = "#" + (e.title.empty()?e.parentTitle:e.title); }
+		if( c.second.nested && not e.bookmark_source ) {
+			std::string bookmark {"#"};
+			bookmark += context.view(e.title ? e.title : parent.title);
+			e.bookmark_source = context.intern(bookmark);
 		}
-		if( e.parentType == "object" || e.parentType == "array" ) {
-			if( e.bookmark_target.empty() ) { e.bookmark_target = e.parentTitle; }
-		}
-
 	}
+	if( not parent.bookmark_target && nested(context.view(parent.type)) ) { parent.bookmark_target = parent.title; }
 
 }
 
-using lambda_t = std::function<void(const Properties&)>;
+// what is required, once all the candidates of an object are known
+static bool finishObject(const OneOf& oneOf, const Required& required, const std::string& element, Context& context,
+                         boilerplateCodeDoc::JsonSchemaObject& parent, Candidates& candidates)
+{
+    if( candidates.empty() ) { return false; } // nothing to filter
+
+    processProperties(oneOf, required, context, parent, candidates);
+    parent.element = context.intern(element);
+    parent.properties.reserve(candidates.size());
+    for(const auto& c : candidates) { parent.properties.emplace_back(c.second.property); }
+    return true;
+}
 
-static void SetProperties(const rapidjson::Document& document, std::string element, const lambda_t& lambda)
+// compile a single object: its own record plus the candidates where to go next
+static bool compileObject(const rapidjson::Value& object, const std::string& element, Context& context,
+                          boilerplateCodeDoc::JsonSchemaObject& parent, Candidates& candidates)
 {
     OneOf oneOf {};
     Required required {};
-    Properties properties {};
-    std::string nextElement {};
 
     // Do nothing if there's nothing to do
-    if( not rapidjson::Pointer(element.c_str()).IsValid() ) { return; }
-    const rapidjson::Value* pointer {rapidjson::Pointer(element.c_str()).Get(document)};
-    if( not pointer ) { return; }
-    if( pointer->IsNull() ) { return; }
-    if( not pointer->IsObject() ) { return; }
-
-    auto&& object {pointer->GetObject()};
-
-    for(rapidjson::Value::ConstMemberIterator i = pointer->GetObject().MemberBegin(); i != pointer->GetObject().MemberEnd(); ++i) {
-        std::string name {i->name.GetString()};
-        if( name == "oneOf" ) {
-            for(auto&& j : object["oneOf"].GetArray()) {
-                Required temp {};
-                for(auto&& k : j["required"].GetArray()) {
-                   temp.emplace_back(std::string{k.GetString()});
+    if( not object.IsObject() ) { return false; }
+
+    // a single pass over the members of the object
+    for(auto i = object.MemberBegin(); i != object.MemberEnd(); ++i) {
+        if( IS_KEY(i->name, "oneOf") ) {
+            getOneOf(i->value, oneOf);
+        } else if( IS_KEY(i->name, "required") ) {
+            getRequired(i->value, required);
+        } else if( IS_KEY(i->name, "properties") ) {
+            getProperties(object, i->value, element + "/properties/", context, parent, candidates);
+        } else if( IS_KEY(i->name, "items") ) {
+            const rapidjson::Value& items {i->value};
+            if( not items.IsObject() ) { continue; }
+            for(auto j = items.MemberBegin(); j != items.MemberEnd(); ++j) {
+                if( IS_KEY(j->name, "properties") ) {
+                    getProperties(items, j->value, element + "/items/properties/", context, parent, candidates);
+                } else if( IS_KEY(j->name, "required") ) {
+                    getRequired(j->value, required);
+                } else if( IS_KEY(j->name, "oneOf") ) {
+                    getOneOf(j->value, oneOf);
                 }
-                oneOf.emplace_back(temp);
-            }
-        } else if( name == "required" ) {
-            for(auto&& j : object["required"].GetArray()) {
-                required.emplace_back(std::string{j.GetString()});
-            }
-        } else if( name == "properties" ) {
-            for(auto&& j = object["properties"].MemberBegin(); j != object["properties"].MemberEnd(); ++j) {
-              std::string name{j->name.GetString()};
-              std::string type {}; // required
-              if(not getString(document, element, "/properties/", name, "/type", type)) { continue; }
-              std::string description {}; // optional
-              getString(document, element, "/properties/", name, "/description", description);
-              std::string title {}; // optional
-              getString(document, element, "/properties/", name, "/title", title);
-              std::string parentTitle {}; // optional
-	      getString(document, element, "", "", "/title", parentTitle);
-          std::string parentcpptype {}; // required
-          if(not getString(document, element, "", "", "/cpptype", parentcpptype)) { continue; }
-	      std::string parentType {}; // required
-	      if(not getString(document, element, "", "", "/type", parentType)) { continue; }
-          std::string cpptype {}; // required
-          if(not getString(document, element, "/properties/", name, "/cpptype", cpptype)) { continue; }
-          std::string jsontype {}; // required
-          if(not getString(document, element, "/properties/", name, "/jsontype", jsontype)) { continue; }
-          std::string metainfo {}; // optional
-	      getString(document, element, "/properties/", name, "/metainfo", metainfo);
-	      std::string scope {}; // optional
-	      getString(document, element, "/properties/", name, "/scope", scope);
-	      std::string bookmark_source {}; // optional
-	      getString(document, element, "/properties/", name, "/bookmarkSource", bookmark_source);
-	      std::string bookmark_target {}; // optional
-	      getString(document, element, "", "", "/bookmarkTarget", bookmark_target);
-	      properties.emplace(std::make_pair(name, Property{false, element, scope, name, type, parentType, description, title,
-                                   parentTitle, cpptype, jsontype, parentcpptype, metainfo, bookmark_source, bookmark_target}));
             }
+        }
+    }
+    return finishObject(oneOf, required, element, context, parent, candidates);
+}
 
-            nextElement = element + "/properties/"; // recursive call
-
-        } else if( name == "items" ) {
-            if(object["items"].GetObject().HasMember("properties")) {
-             auto&& items {object["items"]["properties"].GetObject()};
-             for(auto&& j = items.MemberBegin(); j != items.MemberEnd(); ++j) {
-              std::string name{j->name.GetString()};
-              std::string type {}; // required
-              if(not getString(document, element, "/items/properties/", name, "/type", type)) { continue; }
-              std::string description {}; // optional
-              getString(document, element, "/items/properties/", name, "/description", description);
-              std::string title {}; // optional
-	      getString(document, element, "/items/properties/", name, "/title", title);
-	      std::string parentTitle {}; // optional
-	      getString(document, element, "/items", "", "/title", parentTitle);
-	      std::string parentType {}; // required
-	      if(not getString(document, element, "/items", "", "/type", parentType)) { continue; }
-          std::string parentcpptype {}; // required
-          if(not getString(document, element, "/items", "", "/cpptype", parentcpptype)) { continue; }
-          std::string cpptype {}; // required
-          if(not getString(document, element, "/items/properties/", name, "/cpptype", cpptype)) { continue; }
-          std::string jsontype {}; // required
-          if(not getString(document, element, "/items/properties/", name, "/jsontype", jsontype)) { continue; }
-          std::string metainfo {}; // optional
-	      getString(document, element, "/items/properties/", name, "/metainfo", metainfo);
-	      std::string scope {}; // optional
-	      getString(document, element, "/items/properties/", name, "/scope", scope);
-	      std::string bookmark_source {}; // optional
-	      getString(document, element, "/items/properties/", name, "/bookmarkSource", bookmark_source);
-	      std::string bookmark_target {}; // optional
-	      getString(document, element, "/items", "", "/bookmarkTarget", bookmark_target);
-	      properties.emplace(std::make_pair(name, Property{false, element, scope, name, type, parentType, description, title,
-                                   parentTitle, cpptype, jsontype, parentcpptype, metainfo, bookmark_source, bookmark_target}));
-            }
+// serial compilation: objects are stored in the order the filters must visit them
+static size_t SetProperties(const rapidjson::Value& object, const std::string& element, Context& context,
+                            std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, std::vector<std::string>& refs)
+{
+    Candidates candidates {};
+    boilerplateCodeDoc::JsonSchemaObject parent {};
+    if( not compileObject(object, element, context, parent, candidates) ) { return std::string::npos; }
 
-            nextElement = element + "/items/properties/"; // recursive call
+    size_t index {objects.size()};
+    objects.emplace_back(std::move(parent));
 
-           }
-           if(object["items"].GetObject().HasMember("required")) {
-            for(auto&& j : object["items"]["required"].GetArray()) {
-                required.emplace_back(std::string{j.GetString()});
-            }
-           }
-           if(object["items"].GetObject().HasMember("oneOf")) {
-            for(auto&& j : object["items"]["oneOf"].GetArray()) {
-                Required temp {};
-                for(auto&& k : j["required"].GetArray()) {
-                   temp.emplace_back(std::string{k.GetString()});
-                }
-                oneOf.emplace_back(temp);
-            }
-           }
-	}
+    // referenced definitions are compiled later on, only once
+    for(const auto& c : candidates) {
+        if( c.second.nested && not c.second.ref.empty() ) { refs.emplace_back(c.second.ref); }
     }
-    processProperties(oneOf, required, properties); // what is required
-    lambda(properties); // apply filter
 
     // recursive call
-    for(const auto& p : properties) {
-        if( "object" == p.second.type || "array" == p.second.type) {
-	    SetProperties(document, nextElement + p.second.name, lambda);
+    for(const auto& c : candidates) {
+        if( c.second.nested && c.second.ref.empty() ) {
+            size_t child {SetProperties(*c.second.schema, c.second.element, context, objects, refs)};
+            if( child != std::string::npos ) { objects[index].children.emplace_back(child); }
         }
     }
+    return index;
+}
+
+// parallel compilation: every sibling subtree is compiled on its own
+struct Subtree {
+    bool valid {false};
+    boilerplateCodeDoc::JsonSchemaObject object {};
+    std::vector<std::string> refs {};
+    std::vector<Subtree> children {};
+};
 
+static void SetProperties(boilerplateCodeDoc::ThreadPool& pool, boilerplateCodeDoc::TaskGroup& group,
+                          const rapidjson::Value& object, const std::string& element, Context& context, Subtree& subtree)
+{
+    Candidates candidates {};
+    if( not compileObject(object, element, context, subtree.object, candidates) ) { return; }
+    subtree.valid = true;
+
+    // allocated before any task starts: children are never moved while being compiled
+    size_t count {0};
+    for(const auto& c : candidates) {
+        if( not c.second.nested ) { continue; }
+        if( c.second.ref.empty() ) { ++count; } else { subtree.refs.emplace_back(c.second.ref); }
+    }
+    subtree.children.resize(count);
+
+    size_t k {0};
+    for(const auto& c : candidates) {
+        if( c.second.nested && c.second.ref.empty() ) {
+            Subtree& child {subtree.children[k++]};
+            pool.run(group, [&pool, &group, &context, &child, schema = c.second.schema, e = c.second.element]{
+                SetProperties(pool, group, *schema, e, context, child);
+            });
+        }
+    }
 }
 
-static bool boilerplateOperator(const boilerplateCodeDoc::JsonSchema& jsonSchema, boilerplateCodeDoc::JsonSchemaFilter& filter, const lambda_t& lambda)
+// back to the serial order
+static size_t flatten(Subtree& subtree, std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, std::vector<std::string>& refs)
 {
-    if( not jsonSchema.document_ptr ) {
-	filter.error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
-	filter.message = "Empty document pointer";
-	return false;
+    if( not subtree.valid ) { return std::string::npos; }
+
+    size_t index {objects.size()};
+    objects.emplace_back(std::move(subtree.object));
+    for(auto&& r : subtree.refs) { refs.emplace_back(std::move(r)); }
+    for(auto&& c : subtree.children) {
+        size_t child {flatten(c, objects, refs)};
+        if( child != std::string::npos ) { objects[index].children.emplace_back(child); }
     }
+    return index;
+}
 
-    rapidjson::Document& document {*reinterpret_cast<rapidjson::Document*>(jsonSchema.document_ptr)};
-    try {
-	    if(document.IsNull() || not document.IsObject() ) {
-		filter.error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
-		filter.message = "Root element shouldn't be NULL";
-		return false;
-	    }
+// a whole tree, without following any "$ref"
+static void compileTree(const rapidjson::Value& object, const std::string& element, unsigned threads, Context& context,
+                        std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, std::vector<std::string>& refs)
+{
+    if( threads < 2 ) {
+        SetProperties(object, element, context, objects, refs);
+        return;
+    }
 
-	    //std::string element {"#/properties/imp/items/properties/native"};
-	    std::string element {"#"};
-	    SetProperties(document, element, lambda );
-	    filter.filtered = filter.header + filter.filtered + filter.footer;
+    Subtree root {};
+    {
+        boilerplateCodeDoc::ThreadPool pool {threads};
+        boilerplateCodeDoc::TaskGroup group {};
+        pool.run(group, [&pool, &group, &object, &element, &context, &root]{ SetProperties(pool, group, object, element, context, root); });
+        pool.wait(group);
+    }
+    flatten(root, objects, refs);
+}
 
-	    filter.error = boilerplateCodeDoc::ParseErrorCode::OK;
-	    filter.message = to_string(filter.error);
-	    return true;
+// referenced definition, compiled only once whatever the number of references
+struct Definition {
+    std::vector<boilerplateCodeDoc::JsonSchemaObject> objects {};
+    std::vector<std::string> refs {};
+};
+using Definitions = std::map<std::string, Definition>;
 
-    } catch(...) {
-	filter.error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
-	filter.message = "Unexpected exception";
-	return false;
-    }
+// referring objects first: nested C++ types are declared before being used
+static void sortDefinitions(const std::string& ref, Definitions& definitions, std::set<std::string>& visited, std::vector<Definition*>& sorted)
+{
+    if( not visited.insert(ref).second ) { return; }
+    auto found = definitions.find(ref);
+    if( found == definitions.end() ) { return; }
+    for(const auto& r : found->second.refs) { sortDefinitions(r, definitions, visited, sorted); }
+    sorted.emplace_back(&found->second);
 }
 
-static bool implemented(const std::string& metainfo)
+static void compile(const rapidjson::Value& document, unsigned threads,
+                    std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, boilerplateCodeDoc::JsonSchemaStrings& strings)
 {
-	if( metainfo.empty() ) { return true; } // empty candidates are supposedly implemented
+    std::mutex mutex {};
+    Context context {document, strings, (threads < 2) ? nullptr : &mutex};
+
+    std::vector<std::string> refs {};
+    compileTree(document, "#", threads, context, objects, refs);
+
+    // every referenced definition, even the ones only referenced by other definitions
+    Definitions definitions {};
+    std::vector<std::string> pending {refs};
+    for(size_t i = 0; i < pending.size(); ++i) {
+        std::string ref {pending[i]};
+        if( definitions.count(ref) > 0 ) { continue; }
+        Definition& definition {definitions[ref]};
+        const rapidjson::Value* target {context.resolve(ref)};
+        if( target && target != &document ) { compileTree(*target, ref, threads, context, definition.objects, definition.refs); } // root already compiled
+        pending.insert(pending.end(), definition.refs.begin(), definition.refs.end());
+    }
 
-	// Look for exact matches
-	static std::set<std::string> NOT_IMPLEMENTED {"not implemented", "Not Implemented", "Not implemented", "NOT IMPLEMENTED"};
-	if( NOT_IMPLEMENTED.end() != NOT_IMPLEMENTED.find(metainfo) ) { return false; }
+    // appended after all the objects referring to them
+    std::set<std::string> visited {};
+    std::vector<Definition*> sorted {};
+    for(const auto& r : refs) { sortDefinitions(r, definitions, visited, sorted); }
+    for(auto d = sorted.rbegin(); d != sorted.rend(); ++d) {
+        size_t offset {objects.size()};
+        for(auto&& o : (*d)->objects) {
+            for(auto&& child : o.children) { child += offset; }
+            objects.emplace_back(std::move(o));
+        }
+    }
+}
 
-	// Look for partial matches
-	for(const auto& s : NOT_IMPLEMENTED) { if( metainfo.find(s) != std::string::npos ) { return false; } }
+/****************************************************************************************/
+/*********************** STATS **********************************************************/
+/****************************************************************************************/
 
-	// Implemented because we got any hint
-	return true;
+static std::int64_t nanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-// from rapidjson::pointer to c++ const char* friendly name
-static inline std::string pointer2cppFriendly(const std::string& pointer)
+void boilerplateCodeDoc::JsonSchemaStats::resetPeak()
 {
-	static const std::regex root{"#"};
-	static const std::regex child{"/"};
-	static const std::string cppFriendly{"_"};
-	return std::regex_replace(std::regex_replace(pointer, root, cppFriendly), child, cppFriendly);
+#if defined(__linux__)
+    std::ofstream{"/proc/self/clear_refs"} << "5";
+#endif
 }
 
-// possible global getter
-static inline std::string globalGetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false)
+size_t boilerplateCodeDoc::JsonSchemaStats::peak()
 {
-    return  std::string{"\nbool "} +
-	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
-	    std::string{"getData( "} +
-	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + name +
-	    std::string{"& data )"};
+#if defined(__linux__)
+    std::ifstream status {"/proc/self/status"};
+    for(std::string line; std::getline(status, line); ) {
+	if( line.compare(0, 6, "VmHWM:") == 0 ) { return std::strtoul(line.c_str() + 6, nullptr, 10); }
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
 }
 
-// possible global setter
-static inline std::string globalSetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false)
+void boilerplateCodeDoc::JsonSchemaStats::start(std::string name)
 {
-    return  std::string{"\nbool "} +
-	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
-	    std::string{"setData( const "} +
-	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + name +
-	    std::string{"& data )"};
+    running = boilerplateCodeDoc::JsonSchemaPhase{std::move(name)};
+    if( probe ) { before = probe(); }
+    since = nanoseconds(); // last: nothing else measured
 }
 
+void boilerplateCodeDoc::JsonSchemaStats::stop()
+{
+    running.milliseconds = (nanoseconds() - since) / 1e6;
+    if( probe ) {
+	Counters after {probe()};
+	running.allocations = after.allocations - before.allocations;
+	running.bytes = after.bytes - before.bytes;
+    }
+    running.peak = peak();
+    phases.emplace_back(std::move(running));
+}
 
-static const std::map<const std::string, const std::string> GET_PROTOTYPE {
-     {"UInt", R"(data.XXX = getUInt(YYY);)"}
-};
+std::string boilerplateCodeDoc::JsonSchemaStats::text() const
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-16s %12s %12s %12s %12s\n", "phase", "ms", "allocations", "KiB", "peak KiB");
+    std::string result {line};
+    for(const auto& phase : phases) {
+	std::snprintf(line, sizeof(line), "%-16s %12.2f %12zu %12zu %12zu\n",
+		      phase.name.c_str(), phase.milliseconds, phase.allocations, phase.bytes / 1024, phase.peak);
+	result += line;
+    }
+    return result;
+}
 
-static inline std::string getter(const std::string& jsontype, const std::string& name, const std::string& cppFullName)
+// phase names are ours: nothing to escape
+std::string boilerplateCodeDoc::JsonSchemaStats::json() const
 {
-	static const std::regex XXX{"XXX"};
-	static const std::regex YYY{"YYY"};
+    char object[200];
+    std::string result {"["};
+    for(const auto& phase : phases) {
+	std::snprintf(object, sizeof(object), "%s{\"name\": \"%s\", \"ms\": %.3f, \"allocations\": %zu, \"bytes\": %zu, \"peak_kib\": %zu}",
+		      (result.size() > 1) ? ", " : "", phase.name.c_str(), phase.milliseconds, phase.allocations, phase.bytes, phase.peak);
+	result += object;
+    }
+    return result + "]";
+}
 
-	const auto& found = GET_PROTOTYPE.find(jsontype);
-	if( found != GET_PROTOTYPE.end() ) {
-		return std::regex_replace(std::regex_replace(found->second, XXX, name), YYY, cppFullName);
-	}
-	return std::string{};
+static inline void startPhase(boilerplateCodeDoc::JsonSchemaStats* stats, std::string name)
+{
+    if( stats ) { stats->start(std::move(name)); }
+}
+
+static inline void stopPhase(boilerplateCodeDoc::JsonSchemaStats* stats)
+{
+    if( stats ) { stats->stop(); }
 }
 
 /****************************************************************************************/
+/*********************** FRAGMENTS ******************************************************/
 /****************************************************************************************/
-/****************************************************************************************/
-/*********************** ACTUAL LOGIC CODE **********************************************/
-/****************************************************************************************/
-/****************************************************************************************/
-/****************************************************************************************/
 
-bool boilerplateCodeDoc::JsonSchema2HTML::operator()(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+static constexpr const char* const FRAGMENTS_MAGIC {"boilerplateCodeDoc fragments 2\n"};
+
+const char* boilerplateCodeDoc::buildStamp()
 {
-return boilerplateOperator(jsonSchema, *this, [this, css_class = jsonSchema.css_class](const Properties& properties) {
+    return __DATE__ " " __TIME__;
+}
 
-  if(properties.size() > 0) {
+uint64_t boilerplateCodeDoc::hash64(std::string_view bytes, uint64_t seed)
+{
+    for(unsigned char c : bytes) { seed = (seed ^ c) * 1099511628211ull; }
+    return seed;
+}
 
-    // header
-    std::string parentTitle {};
-    std::string bookmark_target {};
-    for(const auto& p : properties) {
-	if( not p.second.parentTitle.empty() ) { parentTitle = p.second.parentTitle; }
-	if( not p.second.bookmark_target.empty() ) { bookmark_target = p.second.bookmark_target; }
-	if( not p.second.parentTitle.empty() && not p.second.bookmark_target.empty() ) { break; }
+// '\0' after every piece: no piece runs into the next one
+static inline uint64_t hashPiece(std::string_view piece, uint64_t seed)
+{
+    return boilerplateCodeDoc::hash64(std::string_view{"", 1}, boilerplateCodeDoc::hash64(piece, seed));
+}
+
+// whatever filterObject might read from the object, nested objects apart
+static uint64_t hashObject(const boilerplateCodeDoc::JsonSchemaObject& object, const boilerplateCodeDoc::JsonSchemaStrings& s)
+{
+    uint64_t h {boilerplateCodeDoc::hash64({})};
+    for(auto id : {object.element, object.title, object.type, object.cpptype, object.bookmark_target}) { h = hashPiece(s[id], h); }
+    for(const auto& p : object.properties) {
+	for(auto id : {p.name, p.scope, p.type, p.description, p.title, p.cpptype, p.jsontype, p.metainfo, p.bookmark_source}) { h = hashPiece(s[id], h); }
+	const char flags[] {p.required ? 'r' : '-', p.implemented ? 'i' : '-'};
+	h = hashPiece({flags, sizeof(flags)}, h);
     }
-    if(not parentTitle.empty() || not bookmark_target.empty()) {
-	filtered += "<h3 id=\"" + bookmark_target + "\">" + parentTitle + "</h3>\n";
+    return h;
+}
+
+// filter type and parameters, plus the root members begin() might have taken
+static uint64_t fragmentsSalt(const boilerplateCodeDoc::JsonSchema& jsonSchema, const boilerplateCodeDoc::JsonSchemaFilter& filter)
+{
+    uint64_t h {hashPiece(typeid(filter).name(), boilerplateCodeDoc::hash64({}))};
+    const std::string options {filter.options()};
+    for(const std::string* piece : {&filter.extra, &filter.header, &filter.footer, &options,
+				    &jsonSchema.css_class, &jsonSchema.namespace_id, &jsonSchema.cpp_filename, &jsonSchema.cpp_global_data_name}) {
+	h = hashPiece(*piece, h);
     }
-    filtered += "<table class=\"" + css_class + "\">\n";
-    filtered += "<tr><th>Field<th>Scope</th><th>Type</th><th>Description</th><th>Info</th></tr>\n";
+    return h;
+}
 
-    // body
-    for(const auto& p : properties) {
-	    filtered += "<tr>";
-	    if( p.second.bookmark_source.empty() ) {
-		 filtered += "<td>" + p.second.name + "</td>";
-	    } else {
-		 filtered += "<td><a href=\"" + p.second.bookmark_source + "\">" + p.second.name + "</a></td>";
-	    }
-	    filtered += "<td>" + p.second.scope + "</td>";
-	    filtered += "<td>" + p.second.type + "</td>";
-	    filtered += "<td>" + p.second.description + "</td>";
-	    filtered += "<td>" + p.second.metainfo + "</td>";
-	    filtered += "</tr>\n";
+static inline uint64_t fragmentKey(uint64_t objectHash, uint64_t salt)
+{
+    return boilerplateCodeDoc::hash64({reinterpret_cast<const char*>(&objectHash), sizeof(objectHash)}, salt);
+}
+
+// segment of an unchanged object taken from the previous run, otherwise filtered as usual
+static void filterFragment(const boilerplateCodeDoc::JsonSchemaFilter& filter, const boilerplateCodeDoc::JsonSchemaObject& object,
+			   uint64_t objectHash, boilerplateCodeDoc::JsonSchemaSegment& segment)
+{
+    if( filter.fragments ) {
+	const auto& previous {filter.fragments->previous}; // alias
+	auto found {previous.find(fragmentKey(objectHash, filter.fragments->salt))};
+	if( found != previous.end() ) { segment = found->second; return; }
     }
+    filter.filterObject(object, segment);
+}
 
-    if( properties.size() > 0) {
-	filtered += "</table>\n<br /><br />\n";
+// kept for the next run, whether reused or filtered
+static void keepFragment(boilerplateCodeDoc::JsonSchemaFragments& fragments, uint64_t objectHash, const boilerplateCodeDoc::JsonSchemaSegment& segment)
+{
+    uint64_t key {fragmentKey(objectHash, fragments.salt)};
+    if( fragments.previous.count(key) > 0 ) { ++fragments.reused; }
+    fragments.current.emplace(key, segment);
+}
+
+void boilerplateCodeDoc::JsonSchemaFragments::next()
+{
+    previous = std::move(current);
+    current.clear();
+}
+
+// key, text size, text
+bool boilerplateCodeDoc::JsonSchemaFragments::load(const std::string& filename)
+{
+    previous.clear();
+    std::ifstream input {filename, std::ios::binary | std::ios::ate};
+    if( not input.is_open() ) { return false; }
+    uint64_t remaining {static_cast<uint64_t>(input.tellg())};
+    input.seekg(0, std::ios::beg);
+    std::string magic(std::strlen(FRAGMENTS_MAGIC), '\0');
+    if( remaining < magic.size() || not input.read(&magic[0], magic.size()) || magic != FRAGMENTS_MAGIC ) { return false; }
+    remaining -= magic.size();
+
+    // a corrupt size is a cache miss, never a huge allocation
+    auto read = [&input, &remaining](std::string& data) {
+	uint64_t size {0};
+	if( remaining < sizeof(size) || not input.read(reinterpret_cast<char*>(&size), sizeof(size)) ) { return false; }
+	remaining -= sizeof(size);
+	if( size > remaining ) { return false; }
+	remaining -= size;
+	data.resize(size);
+	return static_cast<bool>(input.read(&data[0], size));
+    };
+    for(uint64_t key {0}; remaining >= sizeof(key) && input.read(reinterpret_cast<char*>(&key), sizeof(key)); ) {
+	remaining -= sizeof(key);
+	boilerplateCodeDoc::JsonSchemaSegment segment {};
+	if( not read(segment.text) ) { previous.clear(); return false; }
+	previous.emplace(key, std::move(segment));
     }
-  }
+    if( remaining != 0 ) { previous.clear(); return false; }
+    return true;
+}
 
-}); // return boilerplateOperator
-} // operator()
+bool boilerplateCodeDoc::JsonSchemaFragments::save(const std::string& filename) const
+{
+    std::ofstream output {filename, std::ios::binary | std::ios::trunc};
+    output.write(FRAGMENTS_MAGIC, std::strlen(FRAGMENTS_MAGIC));
+
+    auto write = [&output](const std::string& data) {
+	uint64_t size {data.size()};
+	output.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	output.write(data.data(), data.size());
+    };
+    for(const auto& c : current) {
+	output.write(reinterpret_cast<const char*>(&c.first), sizeof(c.first));
+	write(c.second.text);
+    }
+    return static_cast<bool>(output.flush());
+}
 
 /****************************************************************************************/
-/****************************************************************************************/
-/****************************************************************************************/
-/*********************** ACTUAL LOGIC CODE **********************************************/
-/****************************************************************************************/
-/****************************************************************************************/
+/*********************** SINKS **********************************************************/
 /****************************************************************************************/
 
-bool boilerplateCodeDoc::JsonSchema2H::operator()(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+#if defined(__unix__) || defined(__APPLE__)
+// every byte, whatever the partial writes; 'iov' is consumed
+static bool writeAll(int fd, std::vector<iovec>& iov, size_t& calls)
 {
-if( not jsonSchema.cpp_filename.empty() && not header.empty() ) {
-	header = "/** @file " + jsonSchema.cpp_filename + ".h" + header;
+    size_t first {0};
+    while( first < iov.size() ) {
+	int count {static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX))};
+	ssize_t written {::writev(fd, &iov[first], count)};
+	++calls;
+	if( written < 0 && errno == EINTR ) { continue; }
+	if( written < 0 ) { return false; }
+	for(size_t n = static_cast<size_t>(written); first < iov.size() && n >= iov[first].iov_len; ++first) { n -= iov[first].iov_len; written -= iov[first].iov_len; }
+	if( first < iov.size() && written > 0 ) {
+		iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+		iov[first].iov_len -= written;
+	}
+    }
+    return true;
 }
-if( not jsonSchema.cpp_global_data_name.empty() && not footer.empty() ) {
+#endif
 
-	static const std::string GETTER {R"(
-	/**
-	 * @brief get Data from the json buffer.
-	 * @param [out] Data to be updated.
-	 * @return true if success, false otherwise. Internal status error might be modified.
-	 *
-     */)"};
-	static const std::string SETTER {R"(
-	/**
-	 * @brief set Data for the json buffer.
-	 * @param [in] Data to be updated.
-	 * @return true if success, false otherwise. Internal status error might be modified.
-	 *
-     */)"};
+// large pieces are not copied, but they must be written before returning: they belong to the caller
+bool boilerplateCodeDoc::JsonSchemaFdSink::write(const std::string_view* pieces, size_t count)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    std::vector<iovec> iov {};
+    for(size_t i = 0; i < count; ++i) {
+	const std::string_view& piece {pieces[i]};
+	if( iov.empty() && piece.size() < LARGE && buffer.size() + piece.size() <= CAPACITY ) {
+		buffer.append(piece.data(), piece.size());
+		continue;
+	}
+	if( iov.empty() && not buffer.empty() ) { iov.push_back(iovec{&buffer[0], buffer.size()}); }
+	if( not piece.empty() ) { iov.push_back(iovec{const_cast<char*>(piece.data()), piece.size()}); }
+    }
+    if( iov.empty() ) { return true; }
+    bool result {writeAll(fd, iov, calls)};
+    buffer.clear();
+    return result;
+#else
+    (void)pieces;
+    (void)count;
+    return false;
+#endif
+}
 
-    footer = std::string{"\n\nnamespace "} + jsonSchema.namespace_id + std::string{" {\n"} +
+bool boilerplateCodeDoc::JsonSchemaFdSink::flush()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if( buffer.empty() ) { return true; }
+    std::vector<iovec> iov {iovec{&buffer[0], buffer.size()}};
+    bool result {writeAll(fd, iov, calls)};
+    buffer.clear();
+    return result;
+#else
+    return buffer.empty();
+#endif
+}
+
+bool boilerplateCodeDoc::JsonSchemaFileSink::write(const std::string_view* pieces, size_t count)
+{
+    for(size_t i = 0; i < count; ++i) {
+	if( std::fwrite(pieces[i].data(), 1, pieces[i].size(), file) != pieces[i].size() ) { return false; }
+    }
+    return true;
+}
+
+bool boilerplateCodeDoc::JsonSchemaFileSink::flush()
+{
+    return std::fflush(file) == 0;
+}
+
+bool boilerplateCodeDoc::JsonSchemaStreamSink::write(const std::string_view* pieces, size_t count)
+{
+    for(size_t i = 0; i < count; ++i) { stream->write(pieces[i].data(), pieces[i].size()); }
+    return stream->good();
+}
+
+bool boilerplateCodeDoc::JsonSchemaStreamSink::flush()
+{
+    return stream->flush().good();
+}
+
+bool boilerplateCodeDoc::JsonSchemaBufferSink::write(const std::string_view* pieces, size_t count)
+{
+    size_t size {buffer.size()};
+    for(size_t i = 0; i < count; ++i) { size += pieces[i].size(); }
+    buffer.reserve(size);
+    for(size_t i = 0; i < count; ++i) { buffer.append(pieces[i].data(), pieces[i].size()); }
+    return true;
+}
+
+bool boilerplateCodeDoc::JsonSchemaHashSink::write(const std::string_view* pieces, size_t count)
+{
+    for(size_t i = 0; i < count; ++i) {
+	hash = hash64(pieces[i], hash);
+	size += pieces[i].size();
+    }
+    return true;
+}
+
+/****************************************************************************************/
+/*********************** STREAMING ******************************************************/
+/****************************************************************************************/
+
+// file read in small chunks, never as a whole
+using FilePtr = std::unique_ptr<FILE, int(*)(FILE*)>;
+static constexpr size_t STREAM_BUFFER_SIZE {64 * 1024};
+static constexpr unsigned STREAM_FLAGS {rapidjson::kParseIterativeFlag};
+
+// only the members of the root object, stopping as soon as all of them are known
+struct RootHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, RootHandler> {
+    boilerplateCodeDoc::JsonSchema& jsonSchema;
+    explicit RootHandler(boilerplateCodeDoc::JsonSchema& jsonSchema_) : jsonSchema{jsonSchema_} {}
+
+    size_t depth {0};
+    bool object {false};
+    std::string key {};
+    bool schema {false}, title {false}, description {false}, namespace_id {false}, css_class {false}, cpp_filename {false}, cpptype {false};
+
+    bool done() const { return schema && title && description && namespace_id && css_class && cpp_filename && cpptype; }
+
+    bool Default() { return not done(); }
+    bool StartObject() { if( depth++ == 0 ) { object = true; } return true; }
+    bool EndObject(rapidjson::SizeType) { --depth; return true; }
+    bool StartArray() { ++depth; return true; }
+    bool EndArray(rapidjson::SizeType) { --depth; return true; }
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+	if( depth == 1 ) {
+		key.assign(str, length);
+		if( key == "$schema" ) { schema = true; }
+	}
+	return true;
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+	if( depth != 1 ) { return true; }
+	std::string value {str, length};
+	if( key == "title" ) { title = true; jsonSchema.title = std::move(value); }
+	else if( key == "description" ) { description = true; jsonSchema.description = std::move(value); }
+	else if( key == "namespace" ) { namespace_id = true; jsonSchema.namespace_id = std::move(value); }
+	else if( key == "cssClass" ) { css_class = true; jsonSchema.css_class = std::move(value); }
+	else if( key == "cppFileName" ) { cpp_filename = true; jsonSchema.cpp_filename = std::move(value); }
+	else if( key == "cpptype" ) { cpptype = true; jsonSchema.cpp_global_data_name = boilerplateCodeDoc::cppTypeName(value); }
+	return not done();
+    }
+};
+
+static void prescan(const std::string& filename, boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+    jsonSchema.streaming = true;
+    jsonSchema.filename = filename;
+
+    FilePtr file {std::fopen(filename.c_str(), "rb"), &std::fclose};
+    if( not file ) {
+	jsonSchema.error = boilerplateCodeDoc::ParseErrorCode::UNABLE_OPEN_FILE;
+	jsonSchema.message = to_string(jsonSchema.error);
+	return;
+    }
+
+    char buffer[STREAM_BUFFER_SIZE];
+    rapidjson::FileReadStream input {file.get(), buffer, sizeof(buffer)};
+    rapidjson::Reader reader {};
+    RootHandler handler {jsonSchema};
+    rapidjson::ParseResult ok {reader.Parse<STREAM_FLAGS>(input, handler)};
+    if( not ok && ok.Code() != rapidjson::kParseErrorTermination ) {
+	jsonSchema.error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
+	jsonSchema.message = to_string(jsonSchema.error);
+	jsonSchema.message += " [";
+	jsonSchema.message += std::string(rapidjson::GetParseError_En(ok.Code())) + " : " + std::to_string(ok.Offset());
+	jsonSchema.message += "]";
+	return;
+    }
+
+    // same checks as the document
+    jsonSchema.error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
+    if( not handler.object ) { jsonSchema.message = "Root element of a schema json should be an object"; return; }
+    if( not handler.schema ) { jsonSchema.message = "Missing expected $schema root object"; return; }
+    if( not handler.title ) { jsonSchema.message = "Missing expected schema title"; return; }
+    if( not handler.description ) { jsonSchema.message = "Missing expected schema description"; return; }
+
+    jsonSchema.error = boilerplateCodeDoc::ParseErrorCode::OK;
+    jsonSchema.message = to_string(jsonSchema.error);
+}
+
+// members of a schema object as plain strings, interned only when its object is filtered
+struct StreamMembers {
+    std::string title {}, type {}, cpptype {}, bookmark_target {};
+    std::string description {}, jsontype {}, metainfo {}, scope {}, bookmark_source {};
+};
+
+struct StreamProperty {
+    std::string name {};
+    StreamMembers members {};
+};
+
+// properties found under a "properties" member: the object holding them is the parent candidate
+struct StreamSource {
+    bool items {false}; // "items" members, otherwise the members of the object itself
+    StreamMembers holder {};
+    std::vector<StreamProperty> properties {};
+};
+
+// one per open object or array, so memory depends on schema depth only
+struct StreamFrame {
+    enum class Kind { SCHEMA, ITEMS, PROPERTIES, REQUIRED, ONEOF, ONEOF_ITEM, SKIP };
+    Kind kind {Kind::SKIP};
+    std::string key {};
+    std::string element {};
+    StreamMembers members {};
+    std::vector<StreamSource> sources {};
+    Required required {};
+    OneOf oneOf {};
+};
+
+// SAX events turned into objects, filtered as soon as their subtree is closed
+struct StreamHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, StreamHandler> {
+    using Kind = StreamFrame::Kind;
+
+    const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters;
+    explicit StreamHandler(const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters_) : filters{filters_} {}
+
+    std::vector<StreamFrame> stack {};
+    boilerplateCodeDoc::JsonSchemaStrings strings {}; // only the ones of the object being filtered
+
+    bool reference {false}; // "$ref" found: streaming stops, it would not be followed
+
+    bool Default() { return true; } // numbers, booleans and nulls are not needed
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+	if( length == 4 && std::memcmp(str, "$ref", 4) == 0 ) { reference = true; return false; }
+	stack.back().key.assign(str, length);
+	return true;
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool) { value({str, length}); return true; }
+    bool StartObject() { open(true); return true; }
+    bool EndObject(rapidjson::SizeType) { close(); return true; }
+    bool StartArray() { open(false); return true; }
+    bool EndArray(rapidjson::SizeType) { close(); return true; }
+
+    void value(std::string_view v) {
+	StreamFrame& top {stack.back()};
+	const std::string& key {top.key};
+	if( top.kind == Kind::SCHEMA || top.kind == Kind::ITEMS ) {
+		StreamMembers& m {top.members};
+		if( key == "title" ) { m.title = v; }
+		else if( key == "type" ) { m.type = v; }
+		else if( key == "cpptype" ) { m.cpptype = v; }
+		else if( key == "bookmarkTarget" ) { m.bookmark_target = v; }
+		else if( key == "description" ) { m.description = v; }
+		else if( key == "jsontype" ) { m.jsontype = v; }
+		else if( key == "metainfo" ) { m.metainfo = v; }
+		else if( key == "scope" ) { m.scope = v; }
+		else if( key == "bookmarkSource" ) { m.bookmark_source = v; }
+	} else if( top.kind == Kind::REQUIRED ) {
+		StreamFrame& owner {stack[stack.size() - 2]};
+		if( owner.kind == Kind::ONEOF_ITEM ) {
+			stack[stack.size() - 4].oneOf.back().emplace_back(v);
+		} else {
+			owner.required.emplace_back(v);
+		}
+	} else if( top.kind == Kind::ONEOF_ITEM && key == "required" ) {
+		stack[stack.size() - 3].oneOf.emplace_back(); // not an array, nothing required
+	}
+    }
+
+    void open(bool object) {
+	StreamFrame frame {};
+	if( stack.empty() ) {
+		if( object ) { frame.kind = Kind::SCHEMA; frame.element = "#"; }
+		stack.emplace_back(std::move(frame));
+		return;
+	}
+
+	StreamFrame& top {stack.back()};
+	const std::string& key {top.key};
+	switch( top.kind ) {
+	    case Kind::SCHEMA:
+	    case Kind::ITEMS:
+		if( object && key == "properties" ) {
+			frame.kind = Kind::PROPERTIES;
+			top.sources.emplace_back();
+		} else if( object && key == "items" && top.kind == Kind::SCHEMA ) {
+			frame.kind = Kind::ITEMS;
+			frame.element = top.element + "/items";
+		} else if( not object && key == "required" ) {
+			frame.kind = Kind::REQUIRED;
+		} else if( not object && key == "oneOf" ) {
+			frame.kind = Kind::ONEOF;
+		}
+		break;
+	    case Kind::PROPERTIES:
+		if( object ) {
+			frame.kind = Kind::SCHEMA;
+			frame.element = stack[stack.size() - 2].element + "/properties/" + key;
+		}
+		break;
+	    case Kind::ONEOF:
+		if( object ) { frame.kind = Kind::ONEOF_ITEM; }
+		break;
+	    case Kind::ONEOF_ITEM:
+		if( key == "required" ) {
+			stack[stack.size() - 3].oneOf.emplace_back();
+			if( not object ) { frame.kind = Kind::REQUIRED; }
+		}
+		break;
+	    default:
+		break;
+	}
+	stack.emplace_back(std::move(frame));
+    }
+
+    void close() {
+	StreamFrame frame {std::move(stack.back())};
+	stack.pop_back();
+
+	if( frame.kind == Kind::ITEMS ) {
+
+		// its properties belong to the object holding it
+		StreamFrame& owner {stack.back()};
+		for(auto&& source : frame.sources) {
+			source.items = true;
+			source.holder = frame.members;
+			owner.sources.emplace_back(std::move(source));
+		}
+		owner.required.insert(owner.required.end(), frame.required.begin(), frame.required.end());
+		owner.oneOf.insert(owner.oneOf.end(), frame.oneOf.begin(), frame.oneOf.end());
+
+	} else if( frame.kind == Kind::SCHEMA ) {
+
+		const StreamMembers& m {frame.members};
+		bool root {stack.empty()};
+		bool valid {not m.type.empty() && not m.cpptype.empty() && not m.jsontype.empty()}; // required
+		if( root || (valid && nested(m.type)) ) { filter(frame); }
+
+		// candidate of its parent
+		if( not root && valid ) {
+			const StreamFrame& properties {stack.back()};
+			StreamFrame& owner {stack[stack.size() - 2]};
+			owner.sources.back().properties.emplace_back(StreamProperty{properties.key, std::move(frame.members)});
+		}
+	}
+    }
+
+    // same compilation as the document, but only for the object just closed
+    void filter(StreamFrame& frame) {
+	static const rapidjson::Value NO_DOCUMENT {};
+	strings.clear();
+	Context context {NO_DOCUMENT, strings};
+
+	boilerplateCodeDoc::JsonSchemaObject parent {};
+	Candidates candidates {};
+	for(const auto& source : frame.sources) {
+		const StreamMembers& holder {source.items ? source.holder : frame.members};
+		if( not parent.type ) {
+			if( holder.type.empty() || holder.cpptype.empty() ) { continue; } // required
+			parent.title = context.intern(holder.title);
+			parent.type = context.intern(holder.type);
+			parent.cpptype = context.intern(holder.cpptype);
+			parent.bookmark_target = context.intern(holder.bookmark_target);
+		}
+		for(const auto& p : source.properties) {
+			Candidate candidate {};
+			auto&& e {candidate.property}; // alias
+			const StreamMembers& m {p.members};
+			e.name = context.intern(p.name);
+			e.type = context.intern(m.type);
+			e.description = context.intern(m.description);
+			e.title = context.intern(m.title);
+			e.cpptype = context.intern(m.cpptype);
+			e.jsontype = context.intern(m.jsontype);
+			e.metainfo = context.intern(m.metainfo);
+			e.scope = context.intern(m.scope);
+			e.bookmark_source = context.intern(m.bookmark_source);
+			e.implemented = implemented(m.metainfo);
+			candidate.nested = nested(m.type);
+			candidates.emplace(context.view(e.name), std::move(candidate));
+		}
+	}
+	if( not finishObject(frame.oneOf, frame.required, frame.element, context, parent, candidates) ) { return; }
+
+	uint64_t objectHash {0};
+	for(auto&& f : filters) {
+		if( f->fragments ) { objectHash = hashObject(parent, strings); break; }
+	}
+	for(auto&& f : filters) {
+		boilerplateCodeDoc::JsonSchemaSegment segment {};
+		f->strings = &strings;
+		filterFragment(*f, parent, objectHash, segment);
+		if( f->fragments ) { keepFragment(*f->fragments, objectHash, segment); }
+		if( not f->sink->write(segment.text) ) { f->error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT; } // begin() checked it is there
+	}
+    }
+};
+
+static bool streamFilters(const boilerplateCodeDoc::JsonSchema& jsonSchema, const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters)
+{
+    std::string message {};
+    boilerplateCodeDoc::ParseErrorCode error {boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON};
+
+    FilePtr file {std::fopen(jsonSchema.filename.c_str(), "rb"), &std::fclose};
+    if( file ) {
+	char buffer[STREAM_BUFFER_SIZE];
+	rapidjson::FileReadStream input {file.get(), buffer, sizeof(buffer)};
+	rapidjson::Reader reader {};
+	StreamHandler handler {filters};
+	rapidjson::ParseResult ok {reader.Parse<STREAM_FLAGS>(input, handler)};
+	if( ok ) { return true; }
+
+	if( handler.reference ) {
+		message = "\"$ref\" is not followed while streaming [" + std::to_string(ok.Offset()) + "]";
+	} else {
+		message = to_string(error);
+		message += " [";
+		message += std::string(rapidjson::GetParseError_En(ok.Code())) + " : " + std::to_string(ok.Offset());
+		message += "]";
+	}
+    } else {
+	error = boilerplateCodeDoc::ParseErrorCode::UNABLE_OPEN_FILE;
+	message = to_string(error);
+    }
+
+    for(auto&& filter : filters) {
+	filter->error = error;
+	filter->message = message;
+    }
+    return false;
+}
+
+bool boilerplateCodeDoc::JsonSchemaFilter::begin(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+    streamed = false; // whatever a previous run left behind
+    if( jsonSchema.streaming ) {
+	if( jsonSchema.error != boilerplateCodeDoc::ParseErrorCode::OK ) {
+		error = jsonSchema.error;
+		message = jsonSchema.message;
+		return false;
+	}
+
+	// otherwise every segment would be kept until the end, as without streaming
+	if( not sink ) {
+		error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT;
+		message = "Streaming needs a sink to write every object as soon as it is filtered";
+		return false;
+	}
+
+	// nothing to wait for
+	if( not sink->write(header) ) {
+		error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT;
+		message = "Unable to write the output";
+		return false;
+	}
+	streamed = true;
+	strings = &jsonSchema.strings;
+	return true;
+    }
+
+    if( not jsonSchema.document_ptr ) {
+	error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
+	message = "Empty document pointer";
+	return false;
+    }
+
+    rapidjson::Document& document {*reinterpret_cast<rapidjson::Document*>(jsonSchema.document_ptr)};
+    if(document.IsNull() || not document.IsObject() ) {
+	error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
+	message = "Root element shouldn't be NULL";
+	return false;
+    }
+
+    strings = &jsonSchema.strings;
+    return true;
+}
+
+bool boilerplateCodeDoc::JsonSchemaFilter::end(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+    bool written {true};
+    if( sink ) {
+
+	// piece by piece: never joined; streamed header and segments were already written
+	std::vector<std::string_view> pieces {};
+	if( not streamed ) {
+		pieces.reserve(segments.size() + 3);
+		pieces.emplace_back(header);
+		if( prepend ) {
+			for(auto s = segments.rbegin(); s != segments.rend(); ++s) { pieces.emplace_back(s->text); }
+			pieces.emplace_back(filtered);
+		} else {
+			pieces.emplace_back(filtered);
+			for(const auto& s : segments) { pieces.emplace_back(s.text); }
+		}
+	}
+	pieces.emplace_back(footer);
+	written = sink->write(pieces.data(), pieces.size()) && sink->flush();
+	written = written && error == boilerplateCodeDoc::ParseErrorCode::OK; // streamed objects
+
+    } else {
+
+	// a single join: no output copied again and again while objects were filtered
+	size_t size {header.size() + filtered.size() + footer.size()};
+	for(const auto& s : segments) { size += s.text.size(); }
+
+	std::string result {};
+	result.reserve(size);
+	result += header;
+	if( prepend && not jsonSchema.streaming ) {
+		for(auto s = segments.rbegin(); s != segments.rend(); ++s) { result += s->text; }
+		result += filtered;
+	} else {
+		result += filtered;
+		for(const auto& s : segments) { result += s.text; }
+	}
+	result += footer;
+	filtered = std::move(result);
+    }
+
+    segments.clear();
+    strings = nullptr;
+    streamed = false;
+    if( not written ) {
+	error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT;
+	message = "Unable to write the output";
+	return false;
+    }
+
+    error = boilerplateCodeDoc::ParseErrorCode::OK;
+    message = to_string(error);
+    return true;
+}
+
+bool boilerplateCodeDoc::JsonSchemaFilter::operator()(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+    return boilerplateCodeDoc::applyFilters(jsonSchema, {this});
+}
+
+// every sibling subtree is filtered on its own, each object into its own private segments
+static void filterSubtree(boilerplateCodeDoc::ThreadPool& pool, boilerplateCodeDoc::TaskGroup& group,
+			  const std::vector<boilerplateCodeDoc::JsonSchemaObject>& objects, size_t index, const std::vector<uint64_t>& hashes,
+			  const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters, std::vector<boilerplateCodeDoc::JsonSchemaSegment>& segments)
+{
+    uint64_t objectHash {hashes.empty() ? 0 : hashes[index]};
+    for(size_t f = 0; f < filters.size(); ++f) {
+	filterFragment(*filters[f], objects[index], objectHash, segments[index * filters.size() + f]);
+    }
+    for(auto child : objects[index].children) {
+	pool.run(group, [&pool, &group, &objects, child, &hashes, &filters, &segments]{ filterSubtree(pool, group, objects, child, hashes, filters, segments); });
+    }
+}
+
+static void filterParallel(const boilerplateCodeDoc::JsonSchema& jsonSchema, const std::vector<uint64_t>& hashes,
+			   const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters, unsigned threads)
+{
+    const auto& objects {jsonSchema.objects}; // alias
+    std::vector<boilerplateCodeDoc::JsonSchemaSegment> segments(objects.size() * filters.size());
+
+    // subtree roots are not nested in any other object
+    std::vector<bool> isChild(objects.size(), false);
+    for(const auto& o : objects) { for(auto child : o.children) { isChild[child] = true; } }
+
+    {
+	boilerplateCodeDoc::ThreadPool pool {threads};
+	boilerplateCodeDoc::TaskGroup group {};
+	for(size_t i = 0; i < objects.size(); ++i) {
+		if( isChild[i] ) { continue; }
+		pool.run(group, [&pool, &group, &objects, i, &hashes, &filters, &segments]{ filterSubtree(pool, group, objects, i, hashes, filters, segments); });
+	}
+	pool.wait(group);
+    }
+
+    // stitched back in the serial order
+    for(size_t i = 0; i < objects.size(); ++i) {
+	for(size_t f = 0; f < filters.size(); ++f) {
+		filters[f]->segments.emplace_back(std::move(segments[i * filters.size() + f]));
+	}
+    }
+}
+
+bool boilerplateCodeDoc::applyFilters(const boilerplateCodeDoc::JsonSchema& jsonSchema, const std::vector<boilerplateCodeDoc::JsonSchemaFilter*>& filters, unsigned threads,
+				      boilerplateCodeDoc::JsonSchemaStats* stats)
+{
+    bool result {true};
+    std::vector<boilerplateCodeDoc::JsonSchemaFilter*> ready {};
+    ready.reserve(filters.size());
+
+    try {
+	    bool fragments {false};
+	    for(auto&& filter : filters) {
+		if( filter->begin(jsonSchema) ) { ready.emplace_back(filter); } else { result = false; continue; }
+		if( filter->fragments ) {
+			filter->fragments->current.clear();
+			filter->fragments->current.reserve(jsonSchema.objects.size());
+			filter->fragments->reused = 0;
+			filter->fragments->salt = fragmentsSalt(jsonSchema, *filter);
+			fragments = true;
+		}
+	    }
+
+	    // every object hashed only once, whatever the number of filters
+	    std::vector<uint64_t> hashes {};
+	    if( fragments && not jsonSchema.streaming ) {
+		startPhase(stats, "hash");
+		hashes.reserve(jsonSchema.objects.size());
+		for(const auto& object : jsonSchema.objects) { hashes.emplace_back(hashObject(object, jsonSchema.strings)); }
+		stopPhase(stats);
+	    }
+
+	    if( jsonSchema.streaming ) {
+
+		// objects are compiled and filtered while reading the file
+		startPhase(stats, "stream");
+		bool streamed {streamFilters(jsonSchema, ready)};
+		stopPhase(stats);
+		if( not streamed ) { return false; }
+
+	    } else if( threads < 2 ) {
+
+		// a single traversal of the already compiled intermediate representation
+		// if measured, every filter's share of it is accumulated call by call
+		std::vector<boilerplateCodeDoc::JsonSchemaPhase> shares(stats ? ready.size() : 0);
+		startPhase(stats, "filter");
+
+		// in visiting order anyway: written as soon as filtered, never kept
+		for(auto&& filter : ready) {
+			if( not filter->sink || filter->prepend ) { continue; }
+			std::string_view pieces[] {filter->header, filter->filtered};
+			if( not filter->sink->write(pieces, std::size(pieces)) ) { filter->error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT; }
+			filter->streamed = true;
+		}
+
+		const auto& objects {jsonSchema.objects}; // alias
+		for(size_t i = 0; i < objects.size(); ++i) {
+			for(size_t f = 0; f < ready.size(); ++f) {
+				boilerplateCodeDoc::JsonSchemaSegment segment {};
+				if( stats ) {
+					boilerplateCodeDoc::JsonSchemaStats::Counters before {stats->probe ? stats->probe() : boilerplateCodeDoc::JsonSchemaStats::Counters{}};
+					std::int64_t since {nanoseconds()};
+					filterFragment(*ready[f], objects[i], hashes.empty() ? 0 : hashes[i], segment);
+					shares[f].milliseconds += (nanoseconds() - since) / 1e6;
+					if( stats->probe ) {
+						boilerplateCodeDoc::JsonSchemaStats::Counters after {stats->probe()};
+						shares[f].allocations += after.allocations - before.allocations;
+						shares[f].bytes += after.bytes - before.bytes;
+					}
+				} else {
+					filterFragment(*ready[f], objects[i], hashes.empty() ? 0 : hashes[i], segment);
+				}
+				if( not ready[f]->streamed ) { ready[f]->segments.emplace_back(std::move(segment)); continue; }
+				if( ready[f]->fragments ) { keepFragment(*ready[f]->fragments, hashes[i], segment); }
+				if( not ready[f]->sink->write(segment.text) ) { ready[f]->error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT; }
+			}
+		}
+		stopPhase(stats);
+
+		// shares of the traversal just measured, after it
+		for(size_t f = 0; f < shares.size(); ++f) {
+			shares[f].name = std::string{ready[f]->name()} + " filter";
+			shares[f].peak = stats->phases.back().peak;
+			stats->phases.emplace_back(std::move(shares[f]));
+		}
+
+	    } else {
+		startPhase(stats, "filter");
+		filterParallel(jsonSchema, hashes, ready, threads);
+		stopPhase(stats);
+	    }
+
+	    for(auto&& filter : ready) {
+		startPhase(stats, std::string{filter->name()} + " join");
+
+		// streamed objects were already kept one by one
+		if( filter->fragments && not filter->streamed ) {
+			for(size_t i = 0; i < hashes.size(); ++i) { keepFragment(*filter->fragments, hashes[i], filter->segments[i]); }
+		}
+		result = filter->end(jsonSchema) && result;
+		stopPhase(stats);
+	    }
+	    return result;
+
+    } catch(...) {
+	for(auto&& filter : ready) {
+		filter->error = boilerplateCodeDoc::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON;
+		filter->message = "Unexpected exception";
+	}
+	return false;
+    }
+}
+
+// possible global getter
+static inline std::string globalGetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false)
+{
+    return  std::string{"\nbool "} +
+	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
+	    std::string{"getData( const char* json, size_t length, "} +
+	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + name +
+	    std::string{"& data )"};
+}
+
+// possible global getter from an already parsed document
+static inline std::string globalDomGetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false, bool view = false)
+{
+    return  std::string{"\nbool "} +
+	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
+	    std::string{"getData( const void* document, "} +
+	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + (view?"view::":"") + name +
+	    std::string{"& data )"};
+}
+
+// possible global getter of the view flavour, from a buffer parsed in place
+static inline std::string globalViewGetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false)
+{
+    return  std::string{"\nbool "} +
+	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
+	    std::string{"getData( char* json, "} +
+	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + std::string{"view::"} + name +
+	    std::string{"& data )"};
+}
+
+// possible global setter
+static inline std::string globalSetter(const std::string& namespace_id, const std::string& name, bool addNamespace = false, bool view = false)
+{
+    return  std::string{"\nbool "} +
+	    (addNamespace?(namespace_id.empty()?"":(namespace_id + std::string{"::"})):"") +
+	    std::string{"setData( const "} +
+	    (namespace_id.empty()?"":(namespace_id + std::string{"::"})) + (view?"view::":"") + name +
+	    std::string{"& data, std::string& json )"};
+}
+
+
+// last word of "struct Data" like types
+std::string boilerplateCodeDoc::cppTypeName(std::string_view cpptype)
+{
+	if( cpptype.find_first_of("\r\n") != std::string_view::npos ) { return std::string{}; } // single line expected
+	size_t found {cpptype.rfind(' ')};
+	if( found == std::string_view::npos ) { return std::string{}; }
+	return std::string{cpptype.substr(found + 1)};
+}
+
+// a single append per piece, no temporary strings
+static inline void concat(std::string& output, std::initializer_list<std::string_view> pieces)
+{
+	for(const auto& p : pieces) { output += p; }
+}
+
+// runtime shared by every generated reader and writer
+// readers: rapidjson::Reader events drive a stack of frames, one per open json object or array
+static const std::string GENERATED_RUNTIME {R"(
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <rapidjson/reader.h>
+#include <rapidjson/document.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+
+namespace {
+
+// json scalar as reported by rapidjson::Reader
+struct Scalar {
+	enum Kind { BOOL, NEGATIVE, UNSIGNED, DOUBLE, STRING } kind;
+	bool boolean;
+	int64_t negative;
+	uint64_t number;
+	double real;
+	const char* string;
+	size_t length;
+};
+
+struct Frame;
+
+// what a json object or array is decoded into
+struct Type {
+	unsigned (*key)(const char* name, size_t length); // member id, 0 if unknown; nullptr for arrays
+	bool (*scalar)(void* target, unsigned member, const Scalar& value);
+	bool (*nested)(void* target, unsigned member, bool array, Frame& child);
+};
+
+struct Frame {
+	const Type* type;
+	void* target;
+	unsigned member; // selected by the last key
+};
+
+// std::string and std::pmr::string alike
+template<typename A>
+bool assign(std::basic_string<char, std::char_traits<char>, A>& to, const Scalar& value)
+{
+	if( value.kind != Scalar::STRING ) { return false; }
+	to.assign(value.string, value.length);
+	return true;
+}
+
+// valid as long as the buffer parsed in place, or the document, is
+inline bool assign(std::string_view& to, const Scalar& value)
+{
+	if( value.kind != Scalar::STRING ) { return false; }
+	to = std::string_view{value.string, value.length};
+	return true;
+}
+
+inline bool assign(bool& to, const Scalar& value)
+{
+	if( value.kind != Scalar::BOOL ) { return false; }
+	to = value.boolean;
+	return true;
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && not std::is_same<T, bool>::value, bool>::type assign(T& to, const Scalar& value)
+{
+	if( value.kind == Scalar::UNSIGNED && value.number <= uint64_t(std::numeric_limits<T>::max()) ) { to = T(value.number); return true; }
+	if( value.kind == Scalar::NEGATIVE && std::is_signed<T>::value && value.negative >= int64_t(std::numeric_limits<T>::min()) ) { to = T(value.negative); return true; }
+	return false;
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type assign(T& to, const Scalar& value)
+{
+	switch( value.kind ) {
+	case Scalar::UNSIGNED: to = T(value.number); return true;
+	case Scalar::NEGATIVE: to = T(value.negative); return true;
+	case Scalar::DOUBLE: to = T(value.real); return true;
+	default: return false;
+	}
+}
+
+inline bool noScalar(void*, unsigned, const Scalar&) { return false; }
+inline bool noNested(void*, unsigned, bool, Frame&) { return false; }
+
+inline bool enter(Frame& child, bool array, bool expected, const Type* type, void* target)
+{
+	if( array != expected ) { return false; }
+	child = Frame{type, target, 0};
+	return true;
+}
+
+// V is the member type, std::vector or std::pmr::vector: elements are built in place, with its allocator
+template<typename V>
+bool scalarElement(void* target, unsigned, const Scalar& value)
+{
+	auto& elements {*static_cast<V*>(target)};
+	elements.emplace_back();
+	if( assign(elements.back(), value) ) { return true; }
+	elements.pop_back();
+	return false;
+}
+
+template<typename V, const Type* T>
+bool objectElement(void* target, unsigned, bool array, Frame& child)
+{
+	if( array ) { return false; }
+	auto& elements {*static_cast<V*>(target)};
+	elements.emplace_back();
+	child = Frame{T, &elements.back(), 0};
+	return true;
+}
+
+template<typename V> const Type ARRAY_OF_SCALARS {nullptr, scalarElement<V>, noNested};
+template<typename V, const Type* T> const Type ARRAY_OF_OBJECTS {nullptr, noScalar, objectElement<V, T>};
+
+// unknown members are skipped whatever their value is, null leaves any member untouched
+class Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+public:
+	Handler(const Type* type, void* target) { stack.reserve(16); stack.push_back(Frame{type, target, 0}); }
+
+	bool Null() { return started; }
+	bool Bool(bool b) { Scalar value {}; value.kind = Scalar::BOOL; value.boolean = b; return scalar(value); }
+	bool Int(int i) { return Int64(i); }
+	bool Uint(unsigned u) { return Uint64(u); }
+	bool Int64(int64_t i) {
+		if( i >= 0 ) { return Uint64(uint64_t(i)); }
+		Scalar value {}; value.kind = Scalar::NEGATIVE; value.negative = i; return scalar(value);
+	}
+	bool Uint64(uint64_t u) { Scalar value {}; value.kind = Scalar::UNSIGNED; value.number = u; return scalar(value); }
+	bool Double(double d) { Scalar value {}; value.kind = Scalar::DOUBLE; value.real = d; return scalar(value); }
+	bool String(const char* s, rapidjson::SizeType length, bool) {
+		Scalar value {}; value.kind = Scalar::STRING; value.string = s; value.length = length; return scalar(value);
+	}
+	bool Key(const char* s, rapidjson::SizeType length, bool) {
+		if( skip == 0 ) { stack.back().member = stack.back().type->key(s, length); }
+		return true;
+	}
+	bool StartObject() { return open(false); }
+	bool EndObject(rapidjson::SizeType) { return close(); }
+	bool StartArray() { return open(true); }
+	bool EndArray(rapidjson::SizeType) { return close(); }
+
+private:
+	bool unknown(const Frame& frame) const { return frame.type->key && frame.member == 0; }
+
+	bool scalar(const Scalar& value) {
+		if( skip > 0 ) { return true; }
+		if( not started ) { return false; }
+		const Frame& frame {stack.back()};
+		return unknown(frame) || frame.type->scalar(frame.target, frame.member, value);
+	}
+
+	bool open(bool array) {
+		if( skip > 0 ) { ++skip; return true; }
+		if( not started ) { started = true; return not array; }
+		const Frame& frame {stack.back()};
+		if( unknown(frame) ) { skip = 1; return true; }
+		Frame child {};
+		if( not frame.type->nested(frame.target, frame.member, array, child) ) { return false; }
+		stack.push_back(child);
+		return true;
+	}
+
+	bool close() {
+		if( skip > 0 ) { --skip; return true; }
+		stack.pop_back();
+		return true;
+	}
+
+	std::vector<Frame> stack {};
+	size_t skip {0}; // depth inside an unknown member
+	bool started {false};
+};
+
+bool domValue(const Frame& frame, const rapidjson::Value& value);
+
+// every member visited once, dispatched on its key like Handler does
+bool domContainer(const Frame& frame, const rapidjson::Value& container)
+{
+	if( container.IsObject() ) {
+		Frame member {frame};
+		for(const auto& m : container.GetObject()) {
+			member.member = frame.type->key(m.name.GetString(), m.name.GetStringLength());
+			if( member.member != 0 && not domValue(member, m.value) ) { return false; }
+		}
+		return true;
+	}
+	for(const auto& element : container.GetArray()) {
+		if( not domValue(frame, element) ) { return false; }
+	}
+	return true;
+}
+
+bool domValue(const Frame& frame, const rapidjson::Value& value)
+{
+	Scalar scalar {};
+	switch( value.GetType() ) {
+	case rapidjson::kNullType:
+		return true;
+	case rapidjson::kFalseType:
+	case rapidjson::kTrueType:
+		scalar.kind = Scalar::BOOL; scalar.boolean = value.GetBool();
+		break;
+	case rapidjson::kStringType:
+		scalar.kind = Scalar::STRING; scalar.string = value.GetString(); scalar.length = value.GetStringLength();
+		break;
+	case rapidjson::kNumberType:
+		if( value.IsUint64() ) { scalar.kind = Scalar::UNSIGNED; scalar.number = value.GetUint64(); }
+		else if( value.IsInt64() ) { scalar.kind = Scalar::NEGATIVE; scalar.negative = value.GetInt64(); }
+		else { scalar.kind = Scalar::DOUBLE; scalar.real = value.GetDouble(); }
+		break;
+	case rapidjson::kObjectType:
+	case rapidjson::kArrayType: {
+		Frame child {};
+		return frame.type->nested(frame.target, frame.member, value.IsArray(), child) && domContainer(child, value);
+		}
+	}
+	return frame.type->scalar(frame.target, frame.member, scalar);
+}
+
+// json text of a value, appended: formatted as rapidjson::Writer does
+inline void writeValue(std::string& json, bool value)
+{
+	if( value ) { json.append("true", 4); } else { json.append("false", 5); }
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && not std::is_same<T, bool>::value>::type writeValue(std::string& json, T value)
+{
+	char buffer[24];
+	char* end {std::is_signed<T>::value ? rapidjson::internal::i64toa(int64_t(value), buffer) : rapidjson::internal::u64toa(uint64_t(value), buffer)};
+	json.append(buffer, end - buffer);
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type writeValue(std::string& json, T value)
+{
+	if( not std::isfinite(double(value)) ) { json.append("null", 4); return; } // no json for them
+	char buffer[32];
+	json.append(buffer, rapidjson::internal::dtoa(double(value), buffer) - buffer);
+}
+
+// std::string, std::pmr::string and std::string_view alike: unescaped runs are copied at once
+inline void writeValue(std::string& json, std::string_view value)
+{
+	static const char HEX[] {"0123456789abcdef"};
+	json += '"';
+	size_t run {0};
+	for(size_t i = 0; i < value.size(); ++i) {
+		unsigned char c {static_cast<unsigned char>(value[i])};
+		if( c >= 0x20 && c != '"' && c != '\\' ) { continue; }
+		json.append(value.data() + run, i - run);
+		run = i + 1;
+		switch( c ) {
+		case '"': json.append("\\\"", 2); break;
+		case '\\': json.append("\\\\", 2); break;
+		case '\n': json.append("\\n", 2); break;
+		case '\r': json.append("\\r", 2); break;
+		case '\t': json.append("\\t", 2); break;
+		case '\b': json.append("\\b", 2); break;
+		case '\f': json.append("\\f", 2); break;
+		default: {
+			const char escaped[] {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf]};
+			json.append(escaped, sizeof(escaped));
+			}
+		}
+	}
+	json.append(value.data() + run, value.size() - run);
+	json += '"';
+}
+
+template<typename V>
+void writeScalars(std::string& json, const V& elements)
+{
+	json += '[';
+	for(size_t i = 0; i < elements.size(); ++i) {
+		if( i > 0 ) { json += ','; }
+		writeValue(json, elements[i]);
+	}
+	json += ']';
+}
+
+// room for all the elements, from the size estimate of their struct
+template<typename V, typename F>
+void writeObjects(std::string& json, const V& elements, F write, size_t size)
+{
+	json.reserve(json.size() + 2 + elements.size() * size);
+	json += '[';
+	for(size_t i = 0; i < elements.size(); ++i) {
+		if( i > 0 ) { json += ','; }
+		write(json, elements[i]);
+	}
+	json += ']';
+}
+
+} // namespace
+
+)"};
+
+// known C++ scalars: anything else is not decoded
+static inline bool scalarType(std::string_view cpptype)
+{
+	static const std::set<std::string, std::less<>> SCALARS {
+		"std::string", "std::string_view", "bool", "double", "float",
+		"int", "unsigned", "unsigned int", "long", "unsigned long", "long long", "unsigned long long",
+		"short", "unsigned short", "int8_t", "uint8_t", "int16_t", "uint16_t", "int32_t", "uint32_t", "int64_t", "uint64_t"
+	};
+	return SCALARS.find(cpptype) != SCALARS.end();
+}
+
+// "Deal" from "std::vector<Deal>" or "std::vector<struct Deal>", empty if it is not a vector
+static inline std::string_view vectorElement(std::string_view cpptype)
+{
+	static constexpr std::string_view VECTOR {"std::vector<"};
+	static constexpr std::string_view STRUCT {"struct "};
+	if( cpptype.size() <= VECTOR.size() || cpptype.compare(0, VECTOR.size(), VECTOR) != 0 || cpptype.back() != '>' ) { return std::string_view{}; }
+	std::string_view element {cpptype.substr(VECTOR.size(), cpptype.size() - VECTOR.size() - 1)};
+	if( element.compare(0, STRUCT.size(), STRUCT) == 0 ) { element.remove_prefix(STRUCT.size()); }
+	return element;
+}
+
+// json key as a C string literal
+static inline void keyLiteral(std::string& output, std::string_view key)
+{
+	output += '"';
+	for(char c : key) {
+		if( c == '"' || c == '\\' ) { output += '\\'; }
+		output += c;
+	}
+	output += '"';
+}
+
+// member type as declared: views point into the parsed buffer, pmr containers allocate from the resource of their struct
+static std::string memberType(std::string_view cpptype, bool view, bool pmr)
+{
+	if( not view && not pmr ) { return std::string{cpptype}; }
+	if( cpptype == "std::string" ) { return view ? "std::string_view" : "std::pmr::string"; }
+	std::string_view element {vectorElement(cpptype)};
+	if( element.empty() ) { return std::string{cpptype}; }
+	return (pmr ? "std::pmr::vector<" : "std::vector<") + memberType(element, view, pmr) + ">";
+}
+
+// allocator-aware struct: containers and nested structs get its allocator, so do the elements of its vectors
+// uses-allocator construction needs the (allocator), (const&, allocator) and (&&, allocator) constructors
+static void allocatorConstructors(std::string& output, std::string_view name, bool view,
+				  const std::vector<boilerplateCodeDoc::JsonSchemaProperty>& properties, const boilerplateCodeDoc::JsonSchemaStrings& s)
+{
+	std::string allocated {}, copied {}, moved {};
+	for(const auto& p : properties) {
+		std::string_view cpptype {s[p.cpptype]};
+		std::string_view member {s[p.name]};
+		if( not p.implemented || cpptype.empty() || member.empty() ) { continue; }
+		const char* separator {copied.empty() ? " : " : ", "};
+		if( memberType(cpptype, view, true).compare(0, 10, "std::pmr::") == 0 || cpptype.compare(0, 7, "struct ") == 0 ) {
+			concat(allocated, {allocated.empty() ? " : " : ", ", member, "{allocator}"});
+			concat(copied, {separator, member, "{other.", member, ", allocator}"});
+			concat(moved, {separator, member, "{std::move(other.", member, "), allocator}"});
+		} else {
+			concat(copied, {separator, member, "{other.", member, "}"});
+			concat(moved, {separator, member, "{other.", member, "}"});
+		}
+	}
+	const char* allocator {allocated.empty() ? "const allocator_type&" : "const allocator_type& allocator"}; // unused by scalars only
+	concat(output, {"using allocator_type = std::pmr::polymorphic_allocator<char>;\n\n",
+			"explicit ", name, "(", allocator, " = {})", allocated, " {}\n",
+			name, "(const ", name, "& other, ", allocator, " = {})", copied, " {}\n",
+			name, "(", name, "&& other, ", allocator, ")", moved, " {}\n",
+			name, "(", name, "&&) = default;\n",
+			name, "& operator=(const ", name, "&) = default;\n",
+			name, "& operator=(", name, "&&) = default;\n\n"});
+}
+
+// sax reader of a generated struct: key_, scalar_ and nested_ functions plus its TYPE_ description
+// member ids follow the declaration order, 0 means an unknown key
+// the view flavour, view_ prefixed, shares the key_ function of its struct
+static void reader(std::string& output, std::string_view namespace_id, std::string_view name, bool view,
+		   const std::vector<boilerplateCodeDoc::JsonSchemaProperty>& properties, const boilerplateCodeDoc::JsonSchemaStrings& s)
+{
+	std::string scope {};
+	if( not namespace_id.empty() ) { concat(scope, {namespace_id, "::"}); }
+	if( view ) { scope += "view::"; }
+	std::string id {view ? "view_" : ""};
+	id += name;
+
+	std::map<size_t, std::vector<std::pair<std::string_view, unsigned>>> keys {}; // by length
+	std::string scalars {}, nested {}, declarations {};
+	unsigned member {0};
+	for(const auto& p : properties) {
+		if( not p.implemented ) { continue; }
+		std::string_view cpptype {s[p.cpptype]};
+		std::string_view property {s[p.name]};
+		if( cpptype.empty() || property.empty() ) { continue; } // not declared by JsonSchema2H
+
+		std::string number {std::to_string(member + 1)};
+		std::string_view element {vectorElement(cpptype)};
+		if( scalarType(cpptype) ) {
+			concat(scalars, {"\tcase ", number, ": return assign(data.", property, ", value);\n"});
+		} else if( not element.empty() && scalarType(element) ) {
+			concat(nested, {"\tcase ", number, ": return enter(child, array, true, &ARRAY_OF_SCALARS<decltype(data.", property, ")>, &data.", property, ");\n"});
+		} else if( not element.empty() ) {
+			concat(declarations, {"extern const Type TYPE_", view ? "view_" : "", element, ";\n"});
+			concat(nested, {"\tcase ", number, ": return enter(child, array, true, &ARRAY_OF_OBJECTS<decltype(data.", property,
+					"), &TYPE_", view ? "view_" : "", element, ">, &data.", property, ");\n"});
+		} else if( cpptype.compare(0, 7, "struct ") == 0 ) {
+			std::string type {boilerplateCodeDoc::cppTypeName(cpptype)};
+			if( type.empty() ) { continue; }
+			concat(declarations, {"extern const Type TYPE_", view ? "view_" : "", type, ";\n"});
+			concat(nested, {"\tcase ", number, ": return enter(child, array, false, &TYPE_", view ? "view_" : "", type, ", &data.", property, ");\n"});
+		} else {
+			continue; // unknown C++ type: its key is skipped
+		}
+		keys[property.size()].emplace_back(property, ++member);
+	}
+
+	concat(output, {"\n\n// ", view ? "view::" : "", name, " reader\n\nnamespace {\n", declarations});
+	if( not view ) {
+		concat(output, {"\nunsigned key_", name, "(const char* name, size_t length)\n{\n"});
+		if( not keys.empty() ) {
+			output += "\tswitch( length ) {\n";
+			for(const auto& k : keys) {
+				concat(output, {"\tcase ", std::to_string(k.first), ":\n"});
+				for(const auto& candidate : k.second) {
+					concat(output, {"\t\tif( std::memcmp(name, "});
+					keyLiteral(output, candidate.first);
+					concat(output, {", ", std::to_string(k.first), ") == 0 ) { return ", std::to_string(candidate.second), "; }\n"});
+				}
+				output += "\t\tbreak;\n";
+			}
+			output += "\t}\n";
+		} else {
+			output += "\t(void)name; (void)length;\n";
+		}
+		output += "\treturn 0;\n}\n";
+	}
+
+	if( not scalars.empty() ) {
+		concat(output, {"\nbool scalar_", id, "(void* target, unsigned member, const Scalar& value)\n{\n",
+				"\tauto& data {*static_cast<", scope, name, "*>(target)};\n\tswitch( member ) {\n", scalars, "\t}\n\treturn false;\n}\n"});
+	}
+	if( not nested.empty() ) {
+		concat(output, {"\nbool nested_", id, "(void* target, unsigned member, bool array, Frame& child)\n{\n",
+				"\tauto& data {*static_cast<", scope, name, "*>(target)};\n\tswitch( member ) {\n", nested, "\t}\n\treturn false;\n}\n"});
+	}
+	concat(output, {"\nconst Type TYPE_", id, " {key_", name, ", ",
+			scalars.empty() ? std::string{"noScalar"} : ("scalar_" + id), ", ",
+			nested.empty() ? std::string{"noNested"} : ("nested_" + id), "};\n\n} // namespace\n"});
+}
+
+// what a writer estimates for a value, besides its key: numbers, strings and containers of any size alike
+static constexpr size_t WRITER_VALUE_ESTIMATE {24};
+
+// json writer of a generated struct: every key, with its separator, is a pre-escaped literal appended at once
+static void writer(std::string& output, std::string_view namespace_id, std::string_view name, bool view,
+		   const std::vector<boilerplateCodeDoc::JsonSchemaProperty>& properties, const boilerplateCodeDoc::JsonSchemaStrings& s)
+{
+	std::string scope {};
+	if( not namespace_id.empty() ) { concat(scope, {namespace_id, "::"}); }
+	if( view ) { scope += "view::"; }
+	std::string id {view ? "view_" : ""};
+	id += name;
+
+	std::string body {}, declarations {};
+	size_t estimate {2}; // braces
+	for(const auto& p : properties) {
+		if( not p.implemented ) { continue; }
+		std::string_view cpptype {s[p.cpptype]};
+		std::string_view property {s[p.name]};
+		if( cpptype.empty() || property.empty() ) { continue; } // not declared by JsonSchema2H
+
+		std::string value {};
+		std::string_view element {vectorElement(cpptype)};
+		if( scalarType(cpptype) ) {
+			concat(value, {"\twriteValue(json, data.", property, ");\n"});
+		} else if( not element.empty() && scalarType(element) ) {
+			concat(value, {"\twriteScalars(json, data.", property, ");\n"});
+		} else if( not element.empty() ) {
+			std::string type {view ? "view_" : ""};
+			type += element;
+			concat(declarations, {"void write_", type, "(std::string& json, const ", scope, element, "& data);\nextern const size_t SIZE_", type, ";\n"});
+			concat(value, {"\twriteObjects(json, data.", property, ", write_", type, ", SIZE_", type, ");\n"});
+		} else if( cpptype.compare(0, 7, "struct ") == 0 ) {
+			std::string type {boilerplateCodeDoc::cppTypeName(cpptype)};
+			if( type.empty() ) { continue; }
+			concat(declarations, {"void write_", view ? "view_" : "", type, "(std::string& json, const ", scope, type, "& data);\n"});
+			concat(value, {"\twrite_", view ? "view_" : "", type, "(json, data.", property, ");\n"});
+		} else {
+			continue; // unknown C++ type: not written
+		}
+
+		// {"key": or ,"key": as json text, then as a C string literal
+		std::string key {body.empty() ? "{\"" : ",\""};
+		for(char c : property) {
+			if( c == '"' || c == '\\' ) { key += '\\'; }
+			key += c;
+		}
+		key += "\":";
+		concat(body, {"\tjson.append("});
+		keyLiteral(body, key);
+		concat(body, {", ", std::to_string(key.size()), ");\n", value});
+		estimate += key.size() + WRITER_VALUE_ESTIMATE;
+	}
+	body += body.empty() ? "\tjson.append(\"{}\", 2);\n" : "\tjson += '}';\n";
+
+	concat(output, {"\n\n// ", view ? "view::" : "", name, " writer\n\nnamespace {\n", declarations,
+			"\nvoid write_", id, "(std::string& json, const ", scope, name, "& data)\n{\n", body, "}\n",
+			"\nconst size_t SIZE_", id, " {", std::to_string(estimate), "};\n\n} // namespace\n"});
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+/*********************** ACTUAL LOGIC CODE **********************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+
+bool boilerplateCodeDoc::JsonSchema2HTML::begin(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+  css_class = jsonSchema.css_class;
+  return JsonSchemaFilter::begin(jsonSchema);
+}
+
+void boilerplateCodeDoc::JsonSchema2HTML::filterObject(const boilerplateCodeDoc::JsonSchemaObject& object, boilerplateCodeDoc::JsonSchemaSegment& segment) const
+{
+  const auto& properties {object.properties}; // alias
+  if(properties.size() > 0) {
+
+    std::string& addition {segment.text}; // alias
+    const auto& s {*strings}; // alias
+
+    // header
+    if( object.title || object.bookmark_target ) {
+	concat(addition, {"<h3 id=\"", s[object.bookmark_target], "\">", s[object.title], "</h3>\n"});
+    }
+    concat(addition, {"<table class=\"", css_class, "\">\n"});
+    addition += "<tr><th>Field<th>Scope</th><th>Type</th><th>Description</th><th>Info</th></tr>\n";
+
+    // body
+    for(const auto& p : properties) {
+	    addition += "<tr>";
+	    if( not p.bookmark_source ) {
+		 concat(addition, {"<td>", s[p.name], "</td>"});
+	    } else {
+		 concat(addition, {"<td><a href=\"", s[p.bookmark_source], "\">", s[p.name], "</a></td>"});
+	    }
+	    concat(addition, {"<td>", s[p.scope], "</td>"});
+	    concat(addition, {"<td>", s[p.type], "</td>"});
+	    concat(addition, {"<td>", s[p.description], "</td>"});
+	    concat(addition, {"<td>", s[p.metainfo], "</td>"});
+	    addition += "</tr>\n";
+    }
+
+    if( properties.size() > 0) {
+	addition += "</table>\n<br /><br />\n";
+    }
+  }
+} // filterObject
+
+/****************************************************************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+/*********************** ACTUAL LOGIC CODE **********************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+/****************************************************************************************/
+
+bool boilerplateCodeDoc::JsonSchema2H::begin(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+if( not jsonSchema.cpp_filename.empty() && not header.empty() ) {
+	header = "/** @file " + jsonSchema.cpp_filename + ".h" + header;
+}
+if( views || pmr ) {
+	static const std::string VECTOR {"#include <vector>\n"};
+	size_t found {header.find(VECTOR)};
+	if( found != std::string::npos ) {
+		header.insert(found + VECTOR.size(), std::string{views ? "      #include <string_view>\n" : ""} + (pmr ? "      #include <memory_resource>\n" : ""));
+	}
+}
+if( not jsonSchema.cpp_global_data_name.empty() && not footer.empty() ) {
+
+	static const std::string GETTER {R"(
+	/**
+	 * @brief get Data from the json buffer, decoded while it is parsed: no DOM is built.
+	 * @param [in] json buffer, not necessarily null terminated.
+	 * @param [in] length of the json buffer.
+	 * @param [out] Data to be updated: missing or null members keep their values, arrays are appended to.
+	 * @return true if success, false otherwise. Internal status error might be modified.
+	 *
+     */)"};
+	static const std::string DOM_GETTER {R"(
+	/**
+	 * @brief get Data from an already parsed json document, every member visited once.
+	 * @param [in] document as a const rapidjson::Value*, so this header includes no rapidjson one.
+	 * @param [out] Data to be updated: missing or null members keep their values, arrays are appended to.
+	 * @return true if success, false otherwise.
+	 *
+     */)"};
+	static const std::string VIEW_GETTER {R"(
+	/**
+	 * @brief get the view of Data from a json buffer parsed in place: strings are not copied.
+	 * @param [in,out] json buffer, null terminated, modified by the parsing; it must outlive the view.
+	 * @param [out] view of Data to be updated: missing or null members keep their values, arrays are appended to.
+	 * @return true if success, false otherwise.
+	 *
+     */)"};
+	static const std::string DOM_VIEW_GETTER {R"(
+	/**
+	 * @brief get the view of Data from an already parsed json document: strings are not copied.
+	 * @param [in] document as a const rapidjson::Value*; it must outlive the view.
+	 * @param [out] view of Data to be updated: missing or null members keep their values, arrays are appended to.
+	 * @return true if success, false otherwise.
+	 *
+     */)"};
+	static const std::string SETTER {R"(
+	/**
+	 * @brief set Data for the json buffer.
+	 * @param [in] Data to be written.
+	 * @param [out] json buffer, appended to: reserved once from an estimate of Data size.
+	 * @return true if success, false otherwise. Not finite numbers are written as null.
+	 *
+     */)"};
+	static const std::string VIEW_SETTER {R"(
+	/**
+	 * @brief set the view of Data for the json buffer.
+	 * @param [in] view of Data to be written.
+	 * @param [out] json buffer, appended to.
+	 * @return true if success, false otherwise. Not finite numbers are written as null.
+	 *
+     */)"};
+
+    footer = std::string{"\n\nnamespace "} + jsonSchema.namespace_id + std::string{" {\n"} +
              GETTER +
              globalGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name) + std::string{";\n"} +
+             DOM_GETTER +
+             globalDomGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name) + std::string{";\n"} +
+             (views ? (VIEW_GETTER + globalViewGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name) + std::string{";\n"} +
+                       DOM_VIEW_GETTER + globalDomGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, false, true) + std::string{";\n"}) : std::string{}) +
              SETTER +
              globalSetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name) + std::string{";\n"} +
+             (views ? (VIEW_SETTER + globalSetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, false, true) + std::string{";\n"}) : std::string{}) +
              std::string{"\n} // namespace "} + jsonSchema.namespace_id +
              footer;
 }
 
-return boilerplateOperator(jsonSchema, *this, [this, namespace_id = jsonSchema.namespace_id](const Properties& properties) {
+namespace_id = jsonSchema.namespace_id;
+return JsonSchemaFilter::begin(jsonSchema);
+} // begin
 
+void boilerplateCodeDoc::JsonSchema2H::filterObject(const boilerplateCodeDoc::JsonSchemaObject& object, boilerplateCodeDoc::JsonSchemaSegment& segment) const
+{
+  const auto& properties {object.properties}; // alias
   if(properties.size() > 0) {
 
+    const auto& s {*strings}; // alias
+
     // supposed cpptype is a must
-    std::string parentcpptype {};
-    parentcpptype = properties.begin()->second.parentcpptype;
+    std::string_view parentcpptype {s[object.cpptype]};
     if( parentcpptype.empty() ) { return; } // required
 
     // if nothing is implemented, do nothing
     bool nothing_implemented {true};
     for(const auto& p : properties) {
-	if( implemented(p.second.metainfo) ) { nothing_implemented = false; break; }
+	if( p.implemented ) { nothing_implemented = false; break; }
     }
     if( nothing_implemented ) {
-        filtered = "\n// " + parentcpptype + ": all their properties are not implemented\n\n" + filtered;
+        concat(segment.text, {"\n// ", parentcpptype, ": all their properties are not implemented\n\n"});
 	    return;
     }
 
-    std::string addition {};
-    if( not namespace_id.empty() ) { addition += "namespace " + namespace_id + " {\n"; }
-    addition += "\n" + parentcpptype + " {\n\n";
+    std::string& addition {segment.text}; // alias
+    std::string name {boilerplateCodeDoc::cppTypeName(parentcpptype)};
+    if( not namespace_id.empty() ) { concat(addition, {"namespace ", namespace_id, " {\n"}); }
+    concat(addition, {"\n", parentcpptype, " {\n\n"});
+    if( pmr && not name.empty() ) { allocatorConstructors(addition, name, false, properties, s); }
 
     for(const auto& p : properties) {
 
-	    if( not implemented(p.second.metainfo) ) { addition += "// " + p.second.name + ": " + p.second.metainfo + "\n"; continue; }
+	    if( not p.implemented ) { concat(addition, {"// ", s[p.name], ": ", s[p.metainfo], "\n"}); continue; }
 
-        std::string cpptype {p.second.cpptype};
+        std::string_view cpptype {s[p.cpptype]};
         if( cpptype.empty() ) { continue; } // required
-	    std::string name {p.second.name};
-	    if( name.empty() ) { continue; } // required
+	    std::string_view member {s[p.name]};
+	    if( member.empty() ) { continue; } // required
 
-	    if( not p.second.description.empty() ) { addition += "///@ brief " + p.second.description + "\n"; }
-        addition += cpptype + " " + name + " {};\n";
+	    if( p.description ) { concat(addition, {"///@ brief ", s[p.description], "\n"}); }
+        concat(addition, {memberType(cpptype, false, pmr), " ", member, " {};\n"});
     }
 
-    addition += "\n}; // " + parentcpptype + "\n";
-    if( not namespace_id.empty() ) { addition += "\n} // namespace " + namespace_id + "\n\n"; }
+    concat(addition, {"\n}; // ", parentcpptype, "\n"});
+    if( not namespace_id.empty() ) { concat(addition, {"\n} // namespace ", namespace_id, "\n\n"}); }
 
-    filtered = addition + filtered;
-  }
+    if( not views ) { return; }
 
-}); // return boilerplateOperator
-} // operator()
+    // same members, strings as views: nested struct names are found in the view namespace first
+    std::string scope {namespace_id.empty() ? std::string{"view"} : (namespace_id + "::view")};
+    concat(addition, {"namespace ", scope, " {\n\n/// @brief view of ", parentcpptype, ": strings point into the parsed buffer\n", parentcpptype, " {\n\n"});
+    if( pmr && not name.empty() ) { allocatorConstructors(addition, name, true, properties, s); }
+    for(const auto& p : properties) {
+	    std::string_view cpptype {s[p.cpptype]};
+	    std::string_view member {s[p.name]};
+	    if( not p.implemented || cpptype.empty() || member.empty() ) { continue; }
+	    concat(addition, {memberType(cpptype, true, pmr), " ", member, " {};\n"});
+    }
+    concat(addition, {"\n}; // ", parentcpptype, "\n\n} // namespace ", scope, "\n\n"});
+  }
+} // filterObject
 
 /****************************************************************************************/
 /****************************************************************************************/
@@ -614,69 +2457,223 @@ return boilerplateOperator(jsonSchema, *this, [this, namespace_id = jsonSchema.n
 /****************************************************************************************/
 /****************************************************************************************/
 
-bool boilerplateCodeDoc::JsonSchema2CPP::operator()(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+bool boilerplateCodeDoc::JsonSchema2CPP::begin(const boilerplateCodeDoc::JsonSchema& jsonSchema)
 {
 if( not jsonSchema.cpp_filename.empty() && not header.empty() ) {
 	header = "/** @file " + jsonSchema.cpp_filename + ".cpp" + header;
-	header += "\n#include \"" + jsonSchema.cpp_filename + ".h\"\n\n";
+	header += "\n#include \"" + jsonSchema.cpp_filename + ".h\"\n" + GENERATED_RUNTIME;
 }
 
-std::string GETTER_PREFIX {globalGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true) + std::string{"\n{\n"}};
-std::string GETTER_SUFIX {"\n} // getter\n"};
-std::string SETTER_PREFIX {globalSetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true) + std::string{"\n{\n"}};
-std::string SETTER_SUFIX {"\n} // setter\n"};
+namespace_id = jsonSchema.namespace_id;
+getter_body = globalGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true) + std::string{"\n{\n"};
+if( not jsonSchema.cpp_global_data_name.empty() ) {
+	concat(getter_body, {"\tHandler handler {&TYPE_", jsonSchema.cpp_global_data_name, ", &data};\n",
+			     "\trapidjson::MemoryStream stream {json, length};\n",
+			     "\trapidjson::Reader reader {};\n",
+			     "\treturn not reader.Parse(stream, handler).IsError();\n",
+			     "}\n\n", globalDomGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true), "\n{\n",
+			     "\tconst rapidjson::Value& value {*static_cast<const rapidjson::Value*>(document)};\n",
+			     "\treturn value.IsObject() && domContainer(Frame{&TYPE_", jsonSchema.cpp_global_data_name, ", &data, 0}, value);\n"});
+	if( views ) {
+		concat(getter_body, {"}\n\n", globalViewGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true), "\n{\n",
+				     "\tHandler handler {&TYPE_view_", jsonSchema.cpp_global_data_name, ", &data};\n",
+				     "\trapidjson::InsituStringStream stream {json};\n",
+				     "\trapidjson::Reader reader {};\n",
+				     "\treturn not reader.Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError();\n",
+				     "}\n\n", globalDomGetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true, true), "\n{\n",
+				     "\tconst rapidjson::Value& value {*static_cast<const rapidjson::Value*>(document)};\n",
+				     "\treturn value.IsObject() && domContainer(Frame{&TYPE_view_", jsonSchema.cpp_global_data_name, ", &data, 0}, value);\n"});
+	}
+}
+setter_body = globalSetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true) + std::string{"\n{\n"};
+if( not jsonSchema.cpp_global_data_name.empty() ) {
+	concat(setter_body, {"\tjson.reserve(json.size() + SIZE_", jsonSchema.cpp_global_data_name, ");\n",
+			     "\twrite_", jsonSchema.cpp_global_data_name, "(json, data);\n",
+			     "\treturn true;\n"});
+	if( views ) {
+		concat(setter_body, {"}\n\n", globalSetter(jsonSchema.namespace_id, jsonSchema.cpp_global_data_name, true, true), "\n{\n",
+				     "\tjson.reserve(json.size() + SIZE_view_", jsonSchema.cpp_global_data_name, ");\n",
+				     "\twrite_view_", jsonSchema.cpp_global_data_name, "(json, data);\n",
+				     "\treturn true;\n"});
+	}
+} else {
+	setter_body += "\t(void)data;\n\t(void)json;\n\treturn false;\n";
+}
 
-bool result = boilerplateOperator(jsonSchema, *this, [	this,
-							namespace_id = jsonSchema.namespace_id,
-							&GETTER_PREFIX
-						      ](const Properties& properties) {
+return JsonSchemaFilter::begin(jsonSchema);
+} // begin
 
+void boilerplateCodeDoc::JsonSchema2CPP::filterObject(const boilerplateCodeDoc::JsonSchemaObject& object, boilerplateCodeDoc::JsonSchemaSegment& segment) const
+{
+  const auto& properties {object.properties}; // alias
   if(properties.size() > 0) {
 
+    const auto& s {*strings}; // alias
+
     // supposed cpptype is a must
-    std::string parentType {};
-    parentType = properties.begin()->second.parentType;
+    std::string_view parentType {s[object.type]};
     if( parentType.empty() ) { return; } // required
 
     // if nothing is implemented, do nothing
     bool nothing_implemented {true};
     for(const auto& p : properties) {
-	if( implemented(p.second.metainfo) ) { nothing_implemented = false; break; }
+	if( p.implemented ) { nothing_implemented = false; break; }
     }
     if( nothing_implemented ) {
-	    filtered = "\n// " + parentType + ": all their properties are not implemented\n\n" + filtered;
+	    concat(segment.text, {"\n// ", parentType, ": all their properties are not implemented\n\n"});
 	    return;
     }
 
-    std::string pointer2static {};
+    // members are found by their key, member by member: no json pointer per property
     for(const auto& p : properties) {
+	if( not p.implemented ) { concat(segment.text, {"\n// ", s[p.name], ": ", s[p.metainfo]}); }
+    }
 
-        if( not implemented(p.second.metainfo) ) { pointer2static += "\n// " + p.second.name + ": " + p.second.metainfo; continue; }
+    // same struct as JsonSchema2H declares
+    std::string name {boilerplateCodeDoc::cppTypeName(s[object.cpptype])};
+    if( name.empty() ) { return; }
+    reader(segment.text, namespace_id, name, false, properties, s);
+    writer(segment.text, namespace_id, name, false, properties, s);
+    if( views ) {
+	reader(segment.text, namespace_id, name, true, properties, s);
+	writer(segment.text, namespace_id, name, true, properties, s);
+    }
+  }
+} // filterObject
 
-	    std::string name {p.second.name};
-	    if( name.empty() ) { continue; } // required
-	    std::string e {p.second.element};
-	    if( e.empty() ) { continue; } // required
+bool boilerplateCodeDoc::JsonSchema2CPP::end(const boilerplateCodeDoc::JsonSchema& jsonSchema)
+{
+ static const std::string GETTER_SUFIX {"\n} // getter\n"};
+ static const std::string SETTER_SUFIX {"\n} // setter\n"};
 
-        if( not p.second.description.empty() ) { pointer2static += "\n/// " + p.second.description; }
-	std::string fullName {e+"/"+name};
-	std::string cppFullName {pointer2cppFriendly(fullName)};
-	pointer2static += "\nstatic constexpr const char* const " + cppFullName + "{\"" + fullName + "\"};";
-	std::string getter_call {getter(p.second.jsontype, name, cppFullName)};
-	if( not getter_call.empty() ) { GETTER_PREFIX += getter_call + "\n"; }
+ static const std::string EXTRA_BEGIN {"\n\n// Extra automatic footer: BEGIN\n\n"};
+ static const std::string EXTRA_END {"\n\n// Extra automatic footer: END\n\n"};
 
-    }
+ // into the sink, after the standard 'footer'
+ if( sink ) {
+	bool result = JsonSchemaFilter::end(jsonSchema);
+	std::string_view pieces[] {EXTRA_BEGIN, getter_body, GETTER_SUFIX, "\n\n", setter_body, SETTER_SUFIX, EXTRA_END};
+	bool written {sink->write(pieces, std::size(pieces)) && sink->flush()};
 
-    filtered = pointer2static + filtered;
-  }
-}); // result boilerplateOperator
+	if( result && not written ) {
+		error = boilerplateCodeDoc::ParseErrorCode::ERROR_FILTERING_DOCUMENT;
+		message = "Unable to write the output";
+		return false;
+	}
+	return result;
+ }
+
+ // it'll appear after the standard 'footer'
+ std::string standard {footer};
+ footer += EXTRA_BEGIN +
+             getter_body + GETTER_SUFIX +
+             std::string{"\n\n"} +
+             setter_body + SETTER_SUFIX +
+             EXTRA_END;
+
+ bool result = JsonSchemaFilter::end(jsonSchema);
+ footer = std::move(standard);
+ return result;
+} // end
 
-// it'll appear after the standard 'footer'
-filtered += std::string{"\n\n// Extra automatic footer: BEGIN\n\n"} +
-            GETTER_PREFIX + GETTER_SUFIX +
-            std::string{"\n\n"} +
-            SETTER_PREFIX + SETTER_SUFIX +
-            std::string{"\n\n// Extra automatic footer: END\n\n"};
+/****************************************************************************************/
+/*********************** SYNTHETIC SCHEMAS **********************************************/
+/****************************************************************************************/
 
- return result;
-} // operator()
+size_t boilerplateCodeDoc::JsonSchemaSynthetic::objects() const
+{
+    size_t result {1};
+    for(size_t level = 1; level < depth; ++level) { result = 1 + fanout * result; }
+    return depth > 0 ? result : 0;
+}
+
+size_t boilerplateCodeDoc::JsonSchemaSynthetic::properties() const
+{
+    size_t result {breadth};
+    for(size_t level = 1; level < depth; ++level) { result = breadth + fanout * (1 + result); }
+    return depth > 0 ? result : 0;
+}
+
+// xorshift32: reproducible everywhere, unlike std distributions
+struct SyntheticRandom {
+    uint32_t state;
+    uint32_t operator()() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+};
+
+static void syntheticObject(std::string& json, const boilerplateCodeDoc::JsonSchemaSynthetic& shape, SyntheticRandom& random,
+			    const std::string& title, size_t depth)
+{
+    // type, cpptype, jsontype and extra members
+    static const std::array<std::array<const char*, 4>, 5> LEAVES {{
+	{{"string", "std::string", "String", ""}},
+	{{"integer", "unsigned int", "UInt", ", \"minimum\": 0"}},
+	{{"integer", "int", "Int", ""}},
+	{{"number", "double", "Double", ", \"default\": 0.0"}},
+	{{"array", "std::vector<std::string>", "VectorString", ", \"items\": {\"type\": \"string\"}"}}
+    }};
+    static const std::string WORDS {"lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor "};
+
+    json += "\"type\": \"object\", \"title\": \"" + title + "\", \"cpptype\": \"struct " + title + "\", \"jsontype\": \"object\", \"properties\": {";
+    for(size_t i = 0; i < shape.breadth; ++i) {
+	const auto& leaf {LEAVES[random() % LEAVES.size()]};
+	if( i > 0 ) { json += ", "; }
+	json += "\"field" + std::to_string(i) + "\": {\"type\": \"";
+	json += leaf[0];
+	json += "\", \"cpptype\": \"";
+	json += leaf[1];
+	json += "\", \"jsontype\": \"";
+	json += leaf[2];
+	json += "\"";
+	json += leaf[3];
+	if( shape.description_length > 0 ) {
+		json += ", \"description\": \"";
+		for(size_t c = 0; c < shape.description_length; ++c) { json += WORDS[(i + c) % WORDS.size()]; }
+		json += "\"";
+	}
+	if( random() % 100 < shape.not_implemented ) {
+		json += ", \"metainfo\": \"not implemented\", \"scope\": \"only for stress tests\"";
+	}
+	json += "}";
+    }
+    if( depth > 1 ) {
+	for(size_t i = 0; i < shape.fanout; ++i) {
+		if( shape.breadth > 0 || i > 0 ) { json += ", "; }
+		if( i % 2 == 0 ) {
+			std::string child {title + "O" + std::to_string(i)};
+			json += "\"object" + std::to_string(i) + "\": {";
+			syntheticObject(json, shape, random, child, depth - 1);
+			json += "}";
+		} else {
+			std::string item {title + "A" + std::to_string(i)};
+			json += "\"array" + std::to_string(i) + "\": {\"type\": \"array\", \"title\": \"" + item + "\", \"cpptype\": \"std::vector<" + item + ">\", ";
+			json += "\"jsontype\": \"array of object\", \"items\": {";
+			syntheticObject(json, shape, random, item, depth - 1);
+			json += "}}";
+		}
+	}
+    }
+    json += "}";
+
+    // first field always required, plus another one for every alternative
+    if( shape.breadth == 0 ) { return; }
+    if( shape.one_of == 0 ) {
+	json += ", \"required\": [\"field0\"]";
+	return;
+    }
+    json += ", \"oneOf\": [";
+    for(size_t a = 0; a < shape.one_of; ++a) {
+	if( a > 0 ) { json += ", "; }
+	json += "{\"required\": [\"field0\", \"field" + std::to_string((a + 1) % shape.breadth) + "\"]}";
+    }
+    json += "]";
+}
+
+std::string boilerplateCodeDoc::syntheticSchema(const boilerplateCodeDoc::JsonSchemaSynthetic& shape)
+{
+    SyntheticRandom random {shape.seed ? shape.seed : 1};
+    std::string json {"{\"$schema\": \"http://json-schema.org/draft-04/schema#\", \"description\": \"synthetic\", "};
+    json += "\"namespace\": \"synthetic\", \"cppFileName\": \"synthetic\", \"cssClass\": \"synthetic\"";
+    if( shape.depth > 0 ) { json += ", "; syntheticObject(json, shape, random, "Data", shape.depth); } // otherwise, no object at all
+    json += "}\n";
+    return json;
+}
@@ -0,0 +1,151 @@
+/** @file threadPool.h
+ * @brief Work stealing thread pool shared by the library and the tool.
+ *
+ * @remark Internal header: not installed with boilerplateCodeDoc.h
+ *
+ */
+
+#ifndef BOILERPLATECODEDOC_THREADPOOL_H
+#define BOILERPLATECODEDOC_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boilerplateCodeDoc {
+
+    /// @brief Tasks to be waited for together.
+    struct TaskGroup {
+
+      ///@brief tasks not finished yet
+      std::atomic<size_t> pending {0};
+
+      ///@brief first exception thrown by any of its tasks
+      std::exception_ptr exception {};
+
+      ///@brief protect exception
+      std::mutex mutex {};
+    };
+
+    /// @brief Every worker owns a queue: it pushes and pops at the back, idle workers steal from the front.
+    /// @remark A thread waiting for a group keeps running pending tasks, so tasks may wait for their own subtasks.
+    class ThreadPool {
+    public:
+
+      using Task = std::function<void()>;
+
+      ///@brief start the workers
+      explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+	if( threads == 0 ) { threads = 1; }
+	for(size_t i = 0; i < threads; ++i) { queues.emplace_back(new Queue{}); }
+	for(size_t i = 0; i < threads; ++i) { workers.emplace_back([this, i]{ work(i); }); }
+      }
+
+      ///@brief stop the workers once their queues are empty
+      ~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock {sleep};
+		done = true;
+	}
+	wake.notify_all();
+	for(auto&& w : workers) { w.join(); }
+      }
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      ///@brief number of workers
+      size_t size() const { return workers.size(); }
+
+      ///@brief queue a task, on the own queue if called from a worker
+      void run(TaskGroup& group, Task task) {
+	++group.pending;
+	++queued;
+	size_t index {(current == this) ? self : (next++ % queues.size())};
+	{
+		std::lock_guard<std::mutex> lock {queues[index]->mutex};
+		queues[index]->tasks.emplace_back([&group, task = std::move(task)]{
+			try {
+				task();
+			} catch(...) {
+				std::lock_guard<std::mutex> lock {group.mutex};
+				if( not group.exception ) { group.exception = std::current_exception(); }
+			}
+			--group.pending;
+		});
+	}
+	{
+		std::lock_guard<std::mutex> lock {sleep}; // no wake up lost between predicate check and wait
+	}
+	wake.notify_one();
+      }
+
+      ///@brief wait for all the tasks of a group, running any pending task meanwhile
+      /// @remark rethrows the first exception thrown by the group
+      void wait(TaskGroup& group) {
+	while( group.pending > 0 ) {
+		if( not runOne((current == this) ? self : 0) ) { std::this_thread::yield(); }
+	}
+	if( group.exception ) { std::rethrow_exception(group.exception); }
+      }
+
+    private:
+
+      struct Queue {
+	std::mutex mutex {};
+	std::deque<Task> tasks {};
+      };
+
+      // own queue first (newest task), otherwise steal from the others (oldest task)
+      bool runOne(size_t index) {
+	Task task {};
+	for(size_t i = 0; i < queues.size() && not task; ++i) {
+		Queue& queue {*queues[(index + i) % queues.size()]};
+		std::lock_guard<std::mutex> lock {queue.mutex};
+		if( queue.tasks.empty() ) { continue; }
+		if( i == 0 ) {
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		} else {
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+	}
+	if( not task ) { return false; }
+	--queued;
+	task();
+	return true;
+      }
+
+      void work(size_t index) {
+	current = this;
+	self = index;
+	for(;;) {
+		if( runOne(index) ) { continue; }
+		std::unique_lock<std::mutex> lock {sleep};
+		wake.wait(lock, [this]{ return done || queued > 0; });
+		if( done && queued == 0 ) { return; }
+	}
+      }
+
+      std::vector<std::unique_ptr<Queue>> queues {};
+      std::vector<std::thread> workers {};
+      std::atomic<size_t> queued {0};
+      std::atomic<size_t> next {0};
+      std::mutex sleep {};
+      std::condition_variable wake {};
+      bool done {false};
+
+      static inline thread_local ThreadPool* current {nullptr};
+      static inline thread_local size_t self {0};
+    };
+
+} // namespace
+
+#endif // header
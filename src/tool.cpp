@@ -1,90 +1,735 @@
 #include <iostream>
+#include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <cerrno>
+#endif
 #include "boilerplateCodeDoc.h"
+#include "threadPool.h"
+#include "allocationCounter.h"
 #include "version.h"
 
 using namespace boilerplateCodeDoc;
 
-static bool processFilter(const JsonSchema& schema, const std::string& filename, JsonSchemaFilter& filter)
+/****************************************************************************************/
+/*********************** STATS **********************************************************/
+/****************************************************************************************/
+
+enum class StatsFormat { NONE, TEXT, JSON };
+
+// tool phases next to the library ones, only if asked for
+static void startPhase(JsonSchemaStats* stats, std::string name)
 {
-    // process filter and save result
-    bool result = filter(schema);
+   if( stats ) { stats->start(std::move(name)); }
+}
 
-    if( not result ) {
+static void stopPhase(JsonSchemaStats* stats)
+{
+   if( stats ) { stats->stop(); }
+}
 
-		// if error at filtering, no need to continue
-		std::cout << filter.message << std::endl << std::endl;
+static std::string jsonString(const std::string& text)
+{
+   std::string result {"\""};
+   for(char c : text) {
+	if( c == '"' || c == '\\' ) { result += '\\'; result += c; }
+	else if( static_cast<unsigned char>(c) < 0x20 ) { char escaped[8]; std::snprintf(escaped, sizeof(escaped), "\\u%04x", c); result += escaped; }
+	else { result += c; }
+   }
+   return result + "\"";
+}
 
-    } else {
+static void printStats(const std::string& schema, bool result, const JsonSchemaStats& stats, StatsFormat format)
+{
+   if( format == StatsFormat::JSON ) {
+	std::cout << "{\"schema\": " << jsonString(schema) << ", \"result\": " << (result ? "true" : "false")
+		  << ", \"phases\": " << stats.json() << "}" << std::endl;
+   } else if( format == StatsFormat::TEXT ) {
+	std::cout << stats.text() << std::endl;
+   }
+}
+
+// next to the final one, unique to this process and thread
+static std::string temporaryName(const std::string& filename)
+{
+   std::ostringstream temporary {};
+   temporary << filename << ".tmp";
+#if defined(__unix__) || defined(__APPLE__)
+   temporary << getpid() << "_";
+#endif
+   temporary << std::this_thread::get_id();
+   return temporary.str();
+}
+
+// temporary file renamed into place: nobody ever sees it half written, whoever else is writing the very same file
+static bool writeAtomically(const std::string& filename, const std::string& data)
+{
+   std::string temporary {temporaryName(filename)};
+   {
+	std::ofstream file {temporary, std::ios::binary | std::ios::trunc};
+	if( not file.write(data.c_str(), data.size()) || not file.flush() ) { std::remove(temporary.c_str()); return false; }
+   }
+   if( std::rename(temporary.c_str(), filename.c_str()) != 0 ) { std::remove(temporary.c_str()); return false; }
+   return true;
+}
 
+// chunk by chunk, stopping at the first difference: never the whole target in memory
+static bool sameContents(const std::string& filename, const std::string& filtered, std::string& buffer)
+{
+   std::ifstream target {filename, std::ios::binary | std::ios::ate};
+   if( not target.is_open() ) { return false; }
+   if( static_cast<size_t>(target.tellg()) != filtered.size() ) { return false; }
+   target.seekg(0, std::ios::beg);
+
+   static constexpr size_t CHUNK_SIZE {64 * 1024};
+   buffer.resize(CHUNK_SIZE);
+   for(size_t offset = 0; offset < filtered.size(); offset += CHUNK_SIZE) {
+	size_t size {std::min(CHUNK_SIZE, filtered.size() - offset)};
+	if( not target.read(&buffer[0], size) ) { return false; }
+	if( filtered.compare(offset, size, buffer.data(), size) != 0 ) { return false; }
+   }
+   return true;
+}
+
+// chunk by chunk into a temporary file renamed into place
+static bool copyAtomically(const std::string& from, const std::string& to, std::string& buffer)
+{
+   std::string temporary {temporaryName(to)};
+   {
+	std::ifstream input {from, std::ios::binary};
+	std::ofstream output {temporary, std::ios::binary | std::ios::trunc};
+	static constexpr size_t CHUNK_SIZE {64 * 1024};
+	buffer.resize(CHUNK_SIZE);
+	while( input.read(&buffer[0], CHUNK_SIZE) || input.gcount() > 0 ) { output.write(buffer.data(), input.gcount()); }
+	if( not input.eof() || not output.flush() ) { std::remove(temporary.c_str()); return false; }
+   }
+   if( std::rename(temporary.c_str(), to.c_str()) != 0 ) { std::remove(temporary.c_str()); return false; }
+   return true;
+}
+
+// 'buffer' is only scratch memory, reused from one target file to the next
+static bool writeIfChanged(const std::string& filename, const std::string& filtered, std::string& buffer, std::ostream& log)
+{
 	try {
 		// maybe the target file already exists
 		// in that case, if it already contains the filtered data, no need to overwrite it
-		std::string contents;
+		if( sameContents(filename, filtered, buffer) ) { return true; }
 
-		std::ifstream target {filename};
-		if( target.is_open() ) {
+		if( not writeAtomically(filename, filtered) ) {
+			log << "Error writing " << filename << std::endl;
+			return false;
+		}
 
-		     // allocate all the memory up front
-		     target.seekg(0, std::ios::end);
-		     contents.reserve(target.tellg());
-		     target.seekg(0, std::ios::beg);
+	} catch(...) {
+		log << "Unexpected exception while writing to " << filename << std::endl;
+		return false;
+	}
+	return true;
+}
 
-		     // read data
-		     contents.assign((std::istreambuf_iterator<char>(target)), std::istreambuf_iterator<char>());
+// filter output compared with its target while it is written: only from the first difference on,
+// the target bytes so far and the rest of the output go into a temporary file next to it. Never kept as a whole.
+struct SinkFile final: public JsonSchemaSink {
+   static constexpr size_t CHUNK_SIZE {64 * 1024};
 
-		     // close file
-		     target.close(); // maybe redundant
-		}
+   std::string temporary {};
+   std::FILE* target {nullptr}; // read along as long as the output is the same
+   size_t same {0}; // leading bytes equal to the target ones
+   std::string* buffer {nullptr}; // scratch memory
+#if defined(__unix__) || defined(__APPLE__)
+   int fd {-1};
+   std::unique_ptr<JsonSchemaFdSink> sink {};
+#else
+   std::FILE* file {nullptr};
+   std::unique_ptr<JsonSchemaFileSink> sink {};
+#endif
 
-		if( contents == filter.filtered ) {
+   SinkFile() = default;
+   SinkFile(const SinkFile&) = delete;
+   SinkFile& operator=(const SinkFile&) = delete;
 
-			// no need to continue, target file contains already filtered data
-			return true;
-		}
+   // still there if never renamed
+   ~SinkFile() override {
+	close();
+	if( not temporary.empty() ) { std::remove(temporary.c_str()); }
+   }
+
+   // no target yet: every byte is a difference
+   bool open(const std::string& filename, std::string& buffer_) {
+	buffer = &buffer_;
+	temporary = temporaryName(filename);
+	target = std::fopen(filename.c_str(), "rb");
+	if( target ) { return true; }
+	return diverge();
+   }
+
+   using JsonSchemaSink::write;
+   bool write(const std::string_view* pieces, size_t count) override {
+	size_t i {0};
+	while( not sink && i < count && compare(pieces[i]) ) { ++i; }
+	if( i == count ) { return true; }
+	if( not sink && not diverge() ) { return false; }
+	return sink->write(pieces + i, count - i);
+   }
 
-		std::ofstream filterFile {filename};
-		if(filterFile) {
+   bool flush() override { return not sink || sink->flush(); }
 
-			// write data
-			filterFile.write(filter.filtered.c_str(), filter.filtered.size());
+   // the same bytes as the target, which is not that long
+   bool compare(std::string_view piece) {
+	buffer->resize(CHUNK_SIZE);
+	for(size_t offset = 0; offset < piece.size(); offset += CHUNK_SIZE) {
+		size_t size {std::min(CHUNK_SIZE, piece.size() - offset)};
+		if( std::fread(&(*buffer)[0], 1, size, target) != size ) { return false; }
+		if( piece.compare(offset, size, buffer->data(), size) != 0 ) { return false; }
+	}
+	same += piece.size();
+	return true;
+   }
 
-			// close file
-			filterFile.close(); // maybe redundant
+   // from now on to the temporary file, beginning with the target bytes that were the same
+   bool diverge() {
+#if defined(__unix__) || defined(__APPLE__)
+	fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if( fd < 0 ) { temporary.clear(); return false; }
+	sink = std::make_unique<JsonSchemaFdSink>(fd);
+#else
+	file = std::fopen(temporary.c_str(), "wb");
+	if( not file ) { temporary.clear(); return false; }
+	sink = std::make_unique<JsonSchemaFileSink>(file);
+#endif
+	if( not target ) { return true; }
+	bool result {std::fseek(target, 0, SEEK_SET) == 0};
+	buffer->resize(CHUNK_SIZE);
+	for(size_t offset = 0; result && offset < same; offset += CHUNK_SIZE) {
+		size_t size {std::min(CHUNK_SIZE, same - offset)};
+		result = std::fread(&(*buffer)[0], 1, size, target) == size && sink->write(std::string_view{buffer->data(), size});
+	}
+	std::fclose(target);
+	target = nullptr;
+	return result;
+   }
 
+   // a target longer than the output differs too; whatever is still buffered is flushed, its errors included
+   bool close() {
+	bool result {true};
+	if( target ) { // not diverged yet
+		if( std::fgetc(target) != EOF ) {
+			result = diverge();
 		} else {
-			std::cout << "Error opening " << filename << std::endl;
-			return false;
+			std::fclose(target);
+			target = nullptr;
+			temporary.clear(); // same contents, nothing written
 		}
+	}
+	if( sink ) { result = sink->flush() && result; } // the destructor would ignore a failed last write
+	sink.reset();
+#if defined(__unix__) || defined(__APPLE__)
+	result = (fd < 0 || ::close(fd) == 0) && result;
+	fd = -1;
+#else
+	result = (not file || std::fclose(file) == 0) && result;
+	file = nullptr;
+#endif
+	return result;
+   }
+};
 
-	} catch(...) {
-		std::cout << "Unexpected exception while writing to " << filename << std::endl;
+// the target file is replaced only if its contents changed
+static bool processFilter(const std::string& filename, JsonSchemaFilter& filter, SinkFile& output, std::ostream& log)
+{
+    bool closed {output.close()};
+
+    // filter already applied, just save its result
+    if( filter.error != ParseErrorCode::OK ) {
+
+		// if error at filtering, no need to continue
+		log << filter.message << std::endl << std::endl;
+		return false;
+    }
+    try {
+	if( not closed ) {
+		log << "Error writing " << filename << std::endl;
 		return false;
 	}
+	if( output.temporary.empty() ) { return true; } // the same contents, never written
+	if( std::rename(output.temporary.c_str(), filename.c_str()) != 0 ) {
+		log << "Error writing " << filename << std::endl;
+		return false;
+	}
+	output.temporary.clear();
+
+    } catch(...) {
+	log << "Unexpected exception while writing to " << filename << std::endl;
+	return false;
     }
-    return result;
+    return true;
 }
 
-int main(int argc, char** argv)
+/****************************************************************************************/
+/*********************** CACHE **********************************************************/
+/****************************************************************************************/
+
+static bool hashFile(const std::string& filename, uint64_t& h)
 {
-   if( argc != 4 ) {
-     std::cout << "Usage:\n\n" << argv[0] << " <Json Schema Input File Name> <HTML Output File Name> <C++ header Output File Name>\n\n";
-     return 1;
+   std::ifstream file {filename, std::ios::binary};
+   if( not file.is_open() ) { return false; }
+
+   h = hash64({});
+   char buffer[64 * 1024];
+   while( file.read(buffer, sizeof(buffer)) || file.gcount() > 0 ) { h = hash64({buffer, static_cast<size_t>(file.gcount())}, h); }
+   return file.eof();
+}
+
+// the very build of the generator, known at compile time: a commit edited and built again is another generator
+// library and tool alike, whichever was compiled again
+static const std::string generator {std::string{BoilerplateCodeDoc_VERSION} + " " + buildStamp() + " " + __DATE__ " " __TIME__};
+
+// schema bytes, filter type and parameters and generator build: whatever could change the output
+static std::string cacheKey(uint64_t schema, const std::string& type, const JsonSchemaFilter& filter)
+{
+   uint64_t h {schema};
+   for(const std::string& part : {type, filter.header, filter.footer, filter.extra, filter.options(), generator}) {
+	h = hash64({part.c_str(), part.size() + 1}, h); // '\0' included: no part runs into the next one
    }
+   char key[17];
+   std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(h));
+   return std::string{key} + "." + type;
+}
 
-   std::string schema{argv[1]};
-   std::string html{argv[2]};
-   std::string h{argv[3]};
+// segments of the previous run for that target, whatever the schema contents
+static std::string fragmentsKey(const std::string& target, const std::string& type, const JsonSchemaFilter& filter)
+{
+   return cacheKey(hash64(target), type, filter) + ".fragments";
+}
 
-   JsonSchema jsonSchema{schema};
-   if(jsonSchema.error != ParseErrorCode::OK) { std::cout << jsonSchema.message << std::endl; return 1; }
+static bool readFile(const std::string& filename, std::string& data)
+{
+   std::ifstream file {filename, std::ios::binary | std::ios::ate};
+   if( not file.is_open() ) { return false; }
+   data.resize(file.tellg());
+   file.seekg(0, std::ios::beg);
+   return static_cast<bool>(file.read(&data[0], data.size()));
+}
 
-   JsonSchema2H hFilter{};
-   bool resultH = processFilter(jsonSchema, h, hFilter);
+// one schema and its outputs: a command line or a manifest line
+struct Entry {
+   std::string schema {};
+   std::string html {};
+   std::string h {};
+   std::string cpp {};
+   bool views {false}; // view flavour of every struct too
+   bool pmr {false}; // std::pmr containers, allocator-aware structs
+   std::string namespace_id {}; // instead of the schema one, if any
+};
+
+struct Timing {
+   double load {};
+   double generate {};
+   bool cached {false};
+   size_t reused {0};
+   size_t objects {0};
+   JsonSchemaStats* stats {nullptr}; // phases, if measured
+};
 
+template<typename F>
+static double milliseconds(F&& f)
+{
+   auto start = std::chrono::steady_clock::now();
+   f();
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// fragments of every output of an entry
+struct Fragments {
+   JsonSchemaFragments h {};
+   JsonSchemaFragments html {};
+   JsonSchemaFragments cpp {};
+};
+
+// with a cache directory, neither parsing nor filtering when nothing changed since the last time
+// 'warm' fragments are kept in memory from one call to the next, otherwise they come from the cache directory
+// 'arena', if any, is reused from one call to the next too: no schema loaded into it survives the call
+static bool generate(const Entry& entry, const std::string& cache, std::string& buffer, std::ostream& log, Timing& timing, Fragments* warm = nullptr,
+		     JsonSchemaArena* arena = nullptr)
+{
+   // all the filters are fed by a single traversal
+   JsonSchema2H hFilter{};
    JsonSchema2HTML htmlFilter{};
-   bool resultHTML = processFilter(jsonSchema, html, htmlFilter);
+   JsonSchema2CPP cppFilter{};
+   hFilter.views = cppFilter.views = entry.views;
+   hFilter.pmr = entry.pmr;
+   struct Output {
+	const std::string& filename;
+	JsonSchemaFilter& filter;
+	std::string type;
+	JsonSchemaFragments& fragments;
+	std::string cached {};
+	std::string fragmentsFile {};
+	std::unique_ptr<SinkFile> output {std::make_unique<SinkFile>()};
+   };
+   Fragments cold {};
+   Fragments& kept {warm ? *warm : cold};
+   std::vector<Output> outputs {};
+   outputs.push_back({entry.h, hFilter, "h", kept.h});
+   outputs.push_back({entry.html, htmlFilter, "html", kept.html});
+   if( not entry.cpp.empty() ) { outputs.push_back({entry.cpp, cppFilter, "cpp", kept.cpp}); }
+
+   JsonSchemaStats* stats {timing.stats};
+   if( stats ) { JsonSchemaStats::resetPeak(); } // once per schema, outside its phases
+   uint64_t schemaHash {};
+   bool hit {false};
+   std::vector<std::string> data(outputs.size());
+   timing.load = milliseconds([&]{
+	if( cache.empty() ) { return; }
+	startPhase(stats, "cache lookup");
+	if( hashFile(entry.schema, schemaHash) ) {
+		hit = true;
+		for(size_t i = 0; i < outputs.size(); ++i) {
+			outputs[i].cached = cache + "/" + cacheKey(hash64(entry.namespace_id, schemaHash), outputs[i].type, outputs[i].filter);
+			hit = hit && readFile(outputs[i].cached, data[i]);
+		}
+	}
+	stopPhase(stats);
+   });
+   if( hit ) {
+	bool result {true};
+	timing.cached = true;
+	timing.generate = milliseconds([&]{
+		for(size_t i = 0; i < outputs.size(); ++i) {
+			startPhase(stats, outputs[i].type + " write");
+			result = writeIfChanged(outputs[i].filename, data[i], buffer, log) && result;
+			stopPhase(stats);
+		}
+	});
+	return result;
+   }
+   data.clear();
+
+   std::unique_ptr<JsonSchema> jsonSchema {};
+   JsonSchemaOptions options {};
+   options.stats = stats;
+   timing.load += milliseconds([&]{
+	if( not arena ) { jsonSchema = std::make_unique<JsonSchema>(entry.schema, options); return; }
+	arena->reset();
+	jsonSchema = std::make_unique<JsonSchema>(entry.schema, *arena, options);
+   });
+   if(jsonSchema->error != ParseErrorCode::OK) { log << jsonSchema->message << std::endl; return false; }
+   if( not entry.namespace_id.empty() ) { jsonSchema->namespace_id = entry.namespace_id; }
+
+   bool result {true};
+   timing.generate = milliseconds([&]{
+	std::vector<JsonSchemaFilter*> filters {};
+	for(auto& o : outputs) {
+		filters.emplace_back(&o.filter);
+		if( cache.empty() && not warm ) { continue; }
+
+		// only objects changed since the previous run are filtered again
+		if( not cache.empty() ) {
+			o.fragmentsFile = cache + "/" + fragmentsKey(o.filename, o.type, o.filter);
+			if( o.fragments.previous.empty() ) { o.fragments.load(o.fragmentsFile); }
+		}
+		o.filter.fragments = &o.fragments;
+	}
+	for(auto& o : outputs) {
+		if( o.output->open(o.filename, buffer) ) { o.filter.sink = o.output.get(); continue; }
+		log << "Error writing " << o.filename << std::endl;
+		result = false;
+		return;
+	}
+	applyFilters(*jsonSchema, filters, 0, stats);
+
+	for(auto& o : outputs) {
+		startPhase(stats, o.type + " write");
+		result = processFilter(o.filename, o.filter, *o.output, log) && result;
+		stopPhase(stats);
+	}
+	if( result ) {
+		JsonSchemaStats* storing {cache.empty() ? nullptr : stats};
+		startPhase(storing, "cache store");
+		for(auto& o : outputs) {
+			if( not o.cached.empty() ) { copyAtomically(o.filename, o.cached, buffer); } // concurrent tasks might store the very same key
+			if( not o.fragmentsFile.empty() ) { o.fragments.save(o.fragmentsFile); }
+			timing.reused += o.fragments.reused;
+			timing.objects += jsonSchema->objects.size();
+			if( warm ) { o.fragments.next(); }
+		}
+		stopPhase(storing);
+	}
+   });
+   return result;
+}
+
+// "<schema> <html> <h> [<cpp>]" per line, '#' comments; relative paths are taken from the manifest directory
+static bool readManifest(const std::string& filename, std::vector<Entry>& entries)
+{
+   std::ifstream manifest {filename};
+   if( not manifest.is_open() ) { std::cout << "Unable to open manifest " << filename << std::endl; return false; }
+
+   size_t found = filename.find_last_of("/\\");
+   std::string directory {(found != std::string::npos) ? filename.substr(0, found + 1) : std::string{}};
+   auto path = [&directory](const std::string& p) { return (p.empty() || p[0] == '/') ? p : directory + p; };
+
+   size_t number {0};
+   for(std::string line; std::getline(manifest, line); ) {
+	++number;
+	line = line.substr(0, line.find('#'));
+	std::istringstream fields {line};
+	std::vector<std::string> values {};
+	for(std::string value; fields >> value; ) { values.emplace_back(value); }
+	if( values.empty() ) { continue; }
+	if( values.size() != 3 && values.size() != 4 ) {
+		std::cout << filename << ":" << number << ": expected <schema> <html> <h> [<cpp>]" << std::endl;
+		return false;
+	}
+	values.resize(4);
+	entries.push_back(Entry{path(values[0]), path(values[1]), path(values[2]), path(values[3])});
+   }
+   return true;
+}
+
+static void report(const Entry& entry, bool result, const Timing& timing, StatsFormat format)
+{
+   std::cout << std::fixed << std::setprecision(2) << (result ? "ok     " : "FAILED ") << entry.schema;
+   if( timing.cached ) {
+	std::cout << ": cached " << timing.load << " ms, written " << timing.generate << " ms" << std::endl;
+   } else {
+	std::cout << ": load " << timing.load << " ms, generate " << timing.generate << " ms";
+	if( timing.reused > 0 ) { std::cout << ", " << timing.reused << " of " << timing.objects << " objects reused"; }
+	std::cout << std::endl;
+   }
+   if( timing.stats ) { printStats(entry.schema, result, *timing.stats, format); }
+}
+
+// every schema is an independent task; their messages are printed in manifest order once all of them are done
+// with --stats and several jobs, allocations and peak memory of concurrent schemas are mixed up
+static int batch(const std::string& filename, size_t jobs, const std::string& cache, StatsFormat format, bool views, bool pmr,
+		 const std::string& namespace_id)
+{
+   std::vector<Entry> entries {};
+   if( not readManifest(filename, entries) ) { return 1; }
+   for(auto& e : entries) { e.views = views; e.pmr = pmr; e.namespace_id = namespace_id; }
+
+   std::vector<Timing> timings(entries.size());
+   std::vector<JsonSchemaStats> stats((format != StatsFormat::NONE) ? entries.size() : 0);
+   for(size_t i = 0; i < stats.size(); ++i) {
+	stats[i].probe = allocationCounters;
+	timings[i].stats = &stats[i];
+   }
+   std::vector<std::string> logs(entries.size());
+   std::vector<char> results(entries.size(), 0);
+   auto task = [&](size_t i) {
+	thread_local std::string buffer {}; // once per worker
+	thread_local JsonSchemaArena arena {};
+	std::ostringstream log {};
+	results[i] = generate(entries[i], cache, buffer, log, timings[i], nullptr, &arena);
+	logs[i] = log.str();
+   };
+
+   double wall = milliseconds([&]{
+	if( jobs < 2 ) {
+		for(size_t i = 0; i < entries.size(); ++i) { task(i); }
+	} else {
+		ThreadPool pool {jobs};
+		TaskGroup group {};
+		for(size_t i = 0; i < entries.size(); ++i) { pool.run(group, [&task, i]{ task(i); }); }
+		pool.wait(group);
+	}
+   });
+
+   Timing total {};
+   size_t failed {0}, cached {0};
+   for(size_t i = 0; i < entries.size(); ++i) {
+	std::cout << logs[i];
+	report(entries[i], results[i], timings[i], format);
+	if( timings[i].cached ) { ++cached; }
+	total.load += timings[i].load;
+	total.generate += timings[i].generate;
+	if( not results[i] ) { ++failed; }
+   }
+   std::cout << entries.size() << " schemas, " << failed << " failed, " << cached << " cached, " << jobs << " jobs: "
+	     << "load " << total.load << " ms + generate " << total.generate << " ms in " << wall << " ms wall clock" << std::endl;
+
+   return (failed == 0) ? 0 : 1;
+}
+
+// resident: every schema regenerated as soon as it is saved, with the fragments of its previous run still in memory
+static int watch(const std::vector<Entry>& entries, const std::string& cache, StatsFormat format)
+{
+#if defined(__linux__)
+   int fd {inotify_init1(IN_CLOEXEC)};
+   if( fd < 0 ) { std::cout << "Unable to watch: inotify not available" << std::endl; return 1; }
+
+   // directories, not files: editors often save by renaming a new file over the old one
+   std::vector<int> watches(entries.size(), -1);
+   std::vector<std::string> names(entries.size());
+   for(size_t i = 0; i < entries.size(); ++i) {
+	const std::string& schema {entries[i].schema};
+	size_t found {schema.find_last_of('/')};
+	std::string directory {(found != std::string::npos) ? schema.substr(0, found + 1) : std::string{"."}};
+	names[i] = (found != std::string::npos) ? schema.substr(found + 1) : schema;
+	watches[i] = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if( watches[i] < 0 ) { std::cout << "Unable to watch " << directory << std::endl; close(fd); return 1; }
+   }
+
+   std::vector<Fragments> warm(entries.size());
+   std::vector<uint64_t> hashes(entries.size(), 0);
+   std::string buffer {};
+   JsonSchemaArena arena {};
+   auto regenerate = [&](size_t i) {
+	uint64_t h {0};
+	if( hashFile(entries[i].schema, h) && h == hashes[i] ) { return; } // touched, not changed
+	hashes[i] = h;
+	Timing timing {};
+	JsonSchemaStats stats {};
+	stats.probe = allocationCounters;
+	if( format != StatsFormat::NONE ) { timing.stats = &stats; }
+	bool result {generate(entries[i], cache, buffer, std::cout, timing, &warm[i], &arena)};
+	report(entries[i], result, timing, format);
+   };
+   for(size_t i = 0; i < entries.size(); ++i) { regenerate(i); }
+   std::cout << "Watching " << entries.size() << " schemas" << std::endl;
+
+   alignas(inotify_event) char events[64 * 1024];
+   for(;;) {
+	ssize_t length {read(fd, events, sizeof(events))};
+	if( length < 0 && errno == EINTR ) { continue; }
+	if( length <= 0 ) { break; }
+
+	// every schema once, however many events it got
+	std::vector<bool> changed(entries.size(), false);
+	for(ssize_t offset = 0; offset < length; ) {
+		const inotify_event* event {reinterpret_cast<const inotify_event*>(events + offset)};
+		offset += sizeof(inotify_event) + event->len;
+		if( event->len == 0 ) { continue; }
+		for(size_t i = 0; i < entries.size(); ++i) {
+			if( watches[i] == event->wd && names[i] == event->name ) { changed[i] = true; }
+		}
+	}
+	for(size_t i = 0; i < entries.size(); ++i) { if( changed[i] ) { regenerate(i); } }
+   }
+   close(fd);
+   std::cout << "Unable to keep on watching" << std::endl;
+   return 1;
+#else
+   (void)entries;
+   (void)cache;
+   (void)format;
+   std::cout << "--watch needs inotify, only available on Linux" << std::endl;
+   return 1;
+#endif
+}
+
+// --synthetic <output> [<depth> [<breadth> [<fanout> [<description length> [<not implemented %> [<oneOf alternatives> [<seed>]]]]]]]
+static int synthetic(int argc, char** argv)
+{
+   JsonSchemaSynthetic shape {};
+   size_t* sizes[] {&shape.depth, &shape.breadth, &shape.fanout, &shape.description_length};
+   for(int i = 3; i < argc && i < 7; ++i) { *sizes[i - 3] = std::strtoul(argv[i], nullptr, 10); }
+   if( argc > 7 ) { shape.not_implemented = std::strtoul(argv[7], nullptr, 10); }
+   if( argc > 8 ) { shape.one_of = std::strtoul(argv[8], nullptr, 10); }
+   if( argc > 9 ) { shape.seed = std::strtoul(argv[9], nullptr, 10); }
+   if( shape.depth == 0 ) {
+	std::cout << "Depth should be at least 1, the root object" << std::endl;
+	return 1;
+   }
+
+   std::string json {syntheticSchema(shape)};
+   if( not writeAtomically(argv[2], json) ) {
+	std::cout << "Unable to write " << argv[2] << std::endl;
+	return 1;
+   }
+   std::cout << argv[2] << ": " << shape.objects() << " objects, " << shape.properties() << " properties, " << json.size() << " bytes" << std::endl;
+   return 0;
+}
+
+int main(int argc, char** argv)
+{
+   if( argc >= 3 && argc <= 10 && std::string{argv[1]} == "--synthetic" ) { return synthetic(argc, argv); }
+
+   // [--watch] [--stats[=json]] [--views] [--pmr] [--namespace <namespace>] [--cache <directory>] [--jobs <N>] [--batch <manifest>]
+   size_t jobs {std::thread::hardware_concurrency()};
+   const char* environment {std::getenv("JSONSCHEMA2CPP_CACHE")};
+   std::string cache {environment ? environment : ""};
+   std::string manifest {};
+   std::string namespace_id {};
+   bool watching {false};
+   bool views {false}, pmr {false};
+   StatsFormat format {StatsFormat::NONE};
+   int i {1};
+   while( i < argc && std::string{argv[i]}.compare(0, 2, "--") == 0 ) {
+	std::string option {argv[i]};
+	if( option == "--watch" ) { watching = true; ++i; continue; }
+	if( option == "--stats" ) { format = StatsFormat::TEXT; ++i; continue; }
+	if( option == "--stats=json" ) { format = StatsFormat::JSON; ++i; continue; }
+	if( option == "--views" ) { views = true; ++i; continue; }
+	if( option == "--pmr" ) { pmr = true; ++i; continue; }
+	if( i + 1 == argc ) { break; }
+	if( option == "--jobs" ) { jobs = std::strtoul(argv[i + 1], nullptr, 10); }
+	else if( option == "--cache" ) { cache = argv[i + 1]; }
+	else if( option == "--batch" ) { manifest = argv[i + 1]; }
+	else if( option == "--namespace" ) { namespace_id = argv[i + 1]; }
+	else { break; }
+	i += 2;
+   }
+   allocationCounting(format != StatsFormat::NONE); // otherwise allocations are not even counted
+   int arguments {argc - i};
+
+   if( manifest.empty() ? (arguments != 3 && arguments != 4) : (arguments != 0) ) {
+     std::cout << "Usage:\n\n" << argv[0] << " [--stats[=json]] [--views] [--pmr] [--namespace <Namespace>] [--cache <Directory>] <Json Schema Input File Name> <HTML Output File Name> <C++ header Output File Name> [<C++ source Output File Name>]\n";
+     std::cout << argv[0] << " [--stats[=json]] [--views] [--pmr] [--namespace <Namespace>] [--cache <Directory>] [--jobs <N>] --batch <Manifest File Name>\n";
+     std::cout << argv[0] << " --watch [--stats[=json]] [--views] [--pmr] [--namespace <Namespace>] [--cache <Directory>] (--batch <Manifest File Name> | <Json Schema> <HTML> <C++ header> [<C++ source>])\n";
+     std::cout << argv[0] << " --synthetic <Json Schema Output File Name> [<depth> [<breadth> [<fanout> [<description length> [<not implemented %> [<oneOf alternatives> [<seed>]]]]]]]\n\n";
+     std::cout << "Manifest: one \"<Json Schema> <HTML> <C++ header> [<C++ source>]\" per line, '#' comments\n";
+     std::cout << "Cache: outputs kept by schema contents, filter and generator build; not parsed again if found\n";
+     std::cout << "        JSONSCHEMA2CPP_CACHE environment variable as default directory\n";
+     std::cout << "Watch: stay resident and regenerate every schema as soon as it is saved again\n";
+     std::cout << "Views: string_view flavour of every struct too, read from a buffer parsed in place\n";
+     std::cout << "Pmr: std::pmr containers and allocator-aware structs, a whole request in one memory resource\n";
+     std::cout << "Namespace: generated code in that namespace instead of the schema one, for example to have several flavours in one binary\n";
+     std::cout << "Stats: wall time, allocations, bytes allocated and peak resident memory of every phase, as text or as a JSON object per schema\n";
+     std::cout << "Synthetic: valid schema of the given shape for scale and stress tests, defaults 3 10 2 32 10 2 1\n\n";
+     return 1;
+   }
+
+#if defined(__unix__) || defined(__APPLE__)
+   if( not cache.empty() ) { mkdir(cache.c_str(), 0755); } // already there is fine too
+#endif
+
+   if( watching ) {
+	std::vector<Entry> entries {};
+	if( manifest.empty() ) { entries.push_back(Entry{argv[i], argv[i + 1], argv[i + 2], arguments == 4 ? argv[i + 3] : ""}); }
+	else if( not readManifest(manifest, entries) ) { return 1; }
+	for(auto& e : entries) { e.views = views; e.pmr = pmr; e.namespace_id = namespace_id; }
+	return watch(entries, cache, format);
+   }
+
+   if( not manifest.empty() ) { return batch(manifest, jobs, cache, format, views, pmr, namespace_id); }
 
-   return (resultH && resultHTML) ? 0 : 1;
+   Entry entry {argv[i], argv[i + 1], argv[i + 2], arguments == 4 ? argv[i + 3] : "", views, pmr, namespace_id};
+   std::string buffer {};
+   Timing timing {};
+   JsonSchemaStats stats {};
+   stats.probe = allocationCounters;
+   if( format != StatsFormat::NONE ) { timing.stats = &stats; }
+   bool result {generate(entry, cache, buffer, std::cout, timing)};
+   if( timing.stats ) { printStats(entry.schema, result, stats, format); }
+   return result ? 0 : 1;
 }
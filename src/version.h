@@ -0,0 +1,16 @@
+/** @file version.h
+ * @brief CMAKE genarated header to store version information.
+ *
+ * Version.txt, remote git server, git branch, git hashcode, date/time and compilation host. 
+ *
+ * @remark Use 'strings' command to access to this embedded information.
+ *
+ */
+
+#ifndef BoilerplateCodeDoc_VERSION_H
+#define BoilerplateCodeDoc_VERSION_H
+
+static constexpr const char* BoilerplateCodeDoc_VERSION __attribute__((used)) /*__attribute__((section("DATA")))*/ = "BoilerplateCodeDoc_VERSION: 0.0.1_8d3a98b";
+static constexpr const char* BoilerplateCodeDoc_VERSION_INFO __attribute__((used)) /*__attribute__((section("DATA")))*/ = "BoilerplateCodeDoc_VERSION_INFO: 0.0.1  master 8d3a98b [Sat Oct 17 15:27:10 UTC 2026] @vm";
+
+#endif // BoilerplateCodeDoc_VERSION_H
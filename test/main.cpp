@@ -3,12 +3,20 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
 #include <boost/hana.hpp>
 #include <boost/test/unit_test.hpp>
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/reader.h>
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
 
 #include "boilerplateCodeDoc.h"
+#include "boilerplateExample.h" // generated from json/schema.json
+#include "pmr/boilerplateExample.h" // std::pmr containers in boilerplatePmr::Example, see CMakeLists.txt
 
 namespace hana = boost::hana;
 namespace boiler = boilerplateCodeDoc;
@@ -40,6 +48,15 @@ struct GlobalInit {
 };
 BOOST_GLOBAL_FIXTURE( GlobalInit );
 
+// next to this test binary: taken for granted that CMake copied json schema files in the very directory where it is generated
+static std::string testFile(const char* name)
+{
+   std::string binary{boost::unit_test::framework::master_test_suite().argv[0]};
+   size_t found = binary.find_last_of("/\\");
+   if( found == std::string::npos ) { return name; }
+   return binary.substr(0,found+1) + name;
+}
+
 BOOST_AUTO_TEST_CASE( test000 ) {
    BOOST_TEST_MESSAGE( "\ntest000: BASIC USAGE of HANA lib" );
 
@@ -208,3 +225,860 @@ BOOST_AUTO_TEST_CASE( test004 ) {
    BOOST_CHECK( result );
 }
 
+
+BOOST_AUTO_TEST_CASE( test005 ) {
+   BOOST_TEST_MESSAGE( "\ntest005: Intermediate representation shared by all the filters");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_TEST_MESSAGE( "Json Schema: " << jsonSchema.message);
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+
+   // objects with properties, root first and children in name order
+   const auto& strings {jsonSchema.strings}; // alias
+   BOOST_REQUIRE( jsonSchema.objects.size() == 6 );
+   BOOST_CHECK( strings[jsonSchema.objects[0].element] == "#" );
+   BOOST_CHECK( strings[jsonSchema.objects[0].cpptype] == "struct Data" );
+   BOOST_CHECK( strings[jsonSchema.objects[1].element] == "#/properties/imp" );
+   BOOST_CHECK( strings[jsonSchema.objects[1].cpptype] == "struct Impression" );
+   BOOST_CHECK( strings[jsonSchema.objects[1].bookmark_target] == "Impression" );
+   BOOST_CHECK( strings[jsonSchema.objects[5].cpptype] == "struct Deal" );
+
+   // required, oneOf and not implemented properties already resolved
+   for(const auto& p : jsonSchema.objects[0].properties) {
+	BOOST_TEST_MESSAGE( strings[p.name] << ": " << strings[p.scope] );
+	BOOST_CHECK( p.required == (strings[p.name] == "id" || strings[p.name] == "imp") );
+   }
+   for(const auto& p : jsonSchema.objects[1].properties) {
+	if( strings[p.name] == "banner" ) {
+		BOOST_CHECK( p.required );
+		BOOST_CHECK( not p.implemented );
+		BOOST_CHECK( strings[p.scope] == "required for banner impressions" );
+	} else if( strings[p.name] == "native" ) {
+		BOOST_CHECK( p.implemented );
+		BOOST_CHECK( strings[p.bookmark_source] == "#Native" );
+	}
+   }
+
+   // the very same representation feeds every filter
+   boiler::JsonSchema2H h {};
+   boiler::JsonSchema2CPP cpp {};
+   boiler::JsonSchema2HTML html {};
+   BOOST_CHECK( h(jsonSchema) && cpp(jsonSchema) && html(jsonSchema) );
+   BOOST_CHECK( h.filtered.find("struct Deal {") != std::string::npos );
+   BOOST_CHECK( html.filtered.find("<h3 id=\"Deal\">Deal</h3>") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( test006 ) {
+   BOOST_TEST_MESSAGE( "\ntest006: Several filters fed by a single traversal");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_TEST_MESSAGE( "Json Schema: " << jsonSchema.message);
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+
+   // one by one
+   boiler::JsonSchema2H h {};
+   boiler::JsonSchema2CPP cpp {};
+   boiler::JsonSchema2HTML html {};
+   BOOST_CHECK( h(jsonSchema) && cpp(jsonSchema) && html(jsonSchema) );
+
+   // all together
+   boiler::JsonSchema2H hFanOut {};
+   boiler::JsonSchema2CPP cppFanOut {};
+   boiler::JsonSchema2HTML htmlFanOut {};
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&hFanOut, &cppFanOut, &htmlFanOut}) );
+   BOOST_CHECK( hFanOut.error == boiler::ParseErrorCode::OK );
+   BOOST_CHECK( h.filtered == hFanOut.filtered );
+   BOOST_CHECK( cpp.filtered == cppFanOut.filtered );
+   BOOST_CHECK( html.filtered == htmlFanOut.filtered );
+}
+
+BOOST_AUTO_TEST_CASE( test007 ) {
+   BOOST_TEST_MESSAGE( "\ntest007: Regex free type names");
+
+   BOOST_CHECK( boiler::cppTypeName("struct Data") == "Data" );
+   BOOST_CHECK( boiler::cppTypeName("const struct Data") == "Data" );
+   BOOST_CHECK( boiler::cppTypeName("Data").empty() );
+}
+
+BOOST_AUTO_TEST_CASE( test008 ) {
+   BOOST_TEST_MESSAGE( "\ntest008: Parallel generation as deterministic as the serial one");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema serial{filename};
+   BOOST_REQUIRE( serial.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2H h {};
+   boiler::JsonSchema2CPP cpp {};
+   boiler::JsonSchema2HTML html {};
+   BOOST_REQUIRE( boiler::applyFilters(serial, {&h, &cpp, &html}) );
+
+   // scheduling must not change a single byte
+   for(size_t i = 0; i < 20; ++i) {
+	boiler::JsonSchema parallel{filename, boiler::JsonSchemaOptions{4}};
+	BOOST_REQUIRE( parallel.error == boiler::ParseErrorCode::OK );
+	BOOST_CHECK( parallel.objects.size() == serial.objects.size() );
+	for(size_t o = 0; o < parallel.objects.size() && o < serial.objects.size(); ++o) {
+		// handles depend on the interning order, values do not
+		BOOST_CHECK( parallel.strings[parallel.objects[o].element] == serial.strings[serial.objects[o].element] );
+		BOOST_CHECK( parallel.objects[o].children == serial.objects[o].children );
+	}
+
+	boiler::JsonSchema2H hParallel {};
+	boiler::JsonSchema2CPP cppParallel {};
+	boiler::JsonSchema2HTML htmlParallel {};
+	BOOST_CHECK( boiler::applyFilters(parallel, {&hParallel, &cppParallel, &htmlParallel}, 4) );
+	BOOST_CHECK( h.filtered == hParallel.filtered );
+	BOOST_CHECK( cpp.filtered == cppParallel.filtered );
+	BOOST_CHECK( html.filtered == htmlParallel.filtered );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test009 ) {
+   BOOST_TEST_MESSAGE( "\ntest009: Interned strings");
+
+   boiler::JsonSchemaStrings strings {};
+   BOOST_CHECK( strings.intern("") == 0 );
+   BOOST_CHECK( strings[0].empty() );
+
+   auto optional = strings.intern("optional");
+   BOOST_CHECK( optional != 0 );
+   BOOST_CHECK( strings.intern(std::string{"optional"}) == optional );
+   BOOST_CHECK( strings[optional] == "optional" );
+
+   // bigger than a block: stored anyway and earlier values do not move
+   std::string big(boiler::JsonSchemaStrings::BLOCK_SIZE + 1, 'x');
+   auto view = strings[optional];
+   auto id = strings.intern(big);
+   BOOST_CHECK( strings[id] == big );
+   BOOST_CHECK( strings[optional].data() == view.data() );
+   BOOST_CHECK( strings.views.size() == 3 );
+}
+
+BOOST_AUTO_TEST_CASE( test010 ) {
+   BOOST_TEST_MESSAGE( "\ntest010: Referenced definitions compiled and emitted only once");
+
+   std::string filename{testFile("schemaRefs.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_TEST_MESSAGE( "Json Schema: " << jsonSchema.message);
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+
+   // Data, Impression, Banner and Video plus Format, PMP and Deal: unused definitions are ignored
+   const auto& strings {jsonSchema.strings}; // alias
+   BOOST_REQUIRE( jsonSchema.objects.size() == 7 );
+   BOOST_CHECK( strings[jsonSchema.objects[4].element] == "#/definitions/Format" );
+   BOOST_CHECK( strings[jsonSchema.objects[5].element] == "#/definitions/PMP" );
+   BOOST_CHECK( strings[jsonSchema.objects[6].element] == "#/definitions/Deal" );
+
+   // members of the property prevail over the ones of its definition
+   for(const auto& p : jsonSchema.objects[1].properties) {
+	if( strings[p.name] == "pmp" ) {
+		BOOST_CHECK( strings[p.description] == "Private marketplace container for direct deals" );
+		BOOST_CHECK( strings[p.cpptype] == "struct PMP" );
+		BOOST_CHECK( strings[p.bookmark_source] == "#PMP" );
+	}
+   }
+   for(const auto& p : jsonSchema.objects[0].properties) {
+	if( strings[p.name] == "deals" ) { BOOST_CHECK( strings[p.bookmark_source] == "#Deal" ); }
+   }
+
+   // declared once, before being used
+   boiler::JsonSchema2H h {};
+   boiler::JsonSchema2CPP cpp {};
+   boiler::JsonSchema2HTML html {};
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&h, &cpp, &html}) );
+   size_t deal {h.filtered.find("struct Deal {")};
+   BOOST_REQUIRE( deal != std::string::npos );
+   BOOST_CHECK( h.filtered.find("struct Deal {", deal + 1) == std::string::npos );
+   BOOST_CHECK( deal < h.filtered.find("struct PMP {") );
+   BOOST_CHECK( h.filtered.find("struct Format {") < h.filtered.find("struct Banner {") );
+   BOOST_CHECK( h.filtered.find("struct Unused {") == std::string::npos );
+   BOOST_CHECK( html.filtered.find("<h3 id=\"Deal\">Deal</h3>") != std::string::npos );
+
+   // same result in parallel
+   boiler::JsonSchema parallel{filename, boiler::JsonSchemaOptions{4}};
+   BOOST_REQUIRE( parallel.objects.size() == jsonSchema.objects.size() );
+   boiler::JsonSchema2H hParallel {};
+   BOOST_CHECK( boiler::applyFilters(parallel, {&hParallel}, 4) );
+   BOOST_CHECK( h.filtered == hParallel.filtered );
+}
+
+BOOST_AUTO_TEST_CASE( test011 ) {
+   BOOST_TEST_MESSAGE( "\ntest011: Memory mapped and parsed in place, or read and copied");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchemaOptions copy {};
+   copy.insitu = false;
+   boiler::JsonSchema copied{filename, copy};
+   BOOST_REQUIRE( copied.error == boiler::ParseErrorCode::OK );
+   BOOST_CHECK( copied.mapping_ptr == nullptr );
+   boiler::JsonSchema2H h {};
+   BOOST_CHECK( h(copied) );
+
+   boiler::JsonSchema mapped{filename};
+   BOOST_REQUIRE( mapped.error == boiler::ParseErrorCode::OK );
+   BOOST_CHECK( mapped.mapping_ptr != nullptr );
+   boiler::JsonSchema2H hMapped {};
+   BOOST_CHECK( hMapped(mapped) );
+   BOOST_CHECK( h.filtered == hMapped.filtered );
+
+   // no trailing zero in the file mapping itself when its size is a whole number of pages
+   std::string contents {};
+   {
+	std::ifstream json {filename};
+	contents.assign((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+   }
+   contents.resize((contents.size() / 4096 + 1) * 4096, ' ');
+   std::string padded {filename + ".padded.json"};
+   std::ofstream{padded}.write(contents.c_str(), contents.size());
+   boiler::JsonSchema paddedSchema{padded};
+   BOOST_CHECK( paddedSchema.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2H hPadded {};
+   BOOST_CHECK( hPadded(paddedSchema) );
+   BOOST_CHECK( h.filtered == hPadded.filtered );
+   std::remove(padded.c_str());
+
+   // missing files are still reported as such
+   boiler::JsonSchema missing{filename + ".missing"};
+   BOOST_CHECK( missing.error == boiler::ParseErrorCode::UNABLE_OPEN_FILE );
+}
+
+// element of every filtered object, one per line
+struct Elements final : public boiler::JsonSchemaFilter {
+   void filterObject(const boiler::JsonSchemaObject& object, boiler::JsonSchemaSegment& segment) const override {
+	segment.text = std::string{(*strings)[object.element]} + "\n";
+   }
+};
+
+static std::vector<std::string> lines(const std::string& text)
+{
+   std::vector<std::string> result {};
+   std::istringstream input {text};
+   for(std::string line; std::getline(input, line); ) { result.emplace_back(line); }
+   return result;
+}
+
+BOOST_AUTO_TEST_CASE( test012 ) {
+   BOOST_TEST_MESSAGE( "\ntest012: Streaming without any document");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+
+   boiler::JsonSchemaOptions options {};
+   options.stream = true;
+   boiler::JsonSchema streamed{filename, options};
+   BOOST_TEST_MESSAGE( "Json Schema: " << streamed.message);
+   BOOST_REQUIRE( streamed.error == boiler::ParseErrorCode::OK );
+   BOOST_CHECK( streamed.streaming );
+   BOOST_CHECK( streamed.document_ptr == nullptr );
+   BOOST_CHECK( streamed.objects.empty() );
+   BOOST_CHECK( streamed.title == jsonSchema.title );
+   BOOST_CHECK( streamed.namespace_id == jsonSchema.namespace_id );
+   BOOST_CHECK( streamed.cpp_global_data_name == jsonSchema.cpp_global_data_name );
+
+   // the same objects, every one of them after its nested ones
+   Elements elements {}, streamedElements {};
+   boiler::JsonSchemaBufferSink elementsSink {};
+   streamedElements.sink = &elementsSink;
+   BOOST_CHECK( elements(jsonSchema) && streamedElements(streamed) );
+   auto expected = lines(elements.filtered);
+   auto actual = lines(elementsSink.buffer);
+   BOOST_CHECK( actual.size() == expected.size() );
+   BOOST_CHECK( std::is_permutation(actual.begin(), actual.end(), expected.begin(), expected.end()) );
+   BOOST_REQUIRE( not actual.empty() );
+   BOOST_CHECK( actual.back() == "#" );
+   for(size_t i = 0; i < actual.size(); ++i) {
+	for(size_t j = i + 1; j < actual.size(); ++j) {
+		BOOST_CHECK( actual[i].compare(0, actual[j].size() + 1, actual[j] + "/") == 0 || actual[j].compare(0, actual[i].size() + 1, actual[i] + "/") != 0 );
+	}
+   }
+
+   // same code, declared before being used, written as soon as it is filtered
+   boiler::JsonSchema2H h {}, hStreamed {};
+   boiler::JsonSchema2CPP cpp {}, cppStreamed {}, cppKept {};
+   std::ostringstream hOutput {}, cppOutput {};
+   boiler::JsonSchemaStreamSink hSink {hOutput}, cppSink {cppOutput};
+   boiler::JsonSchemaBufferSink cppBuffer {};
+   hStreamed.sink = &hSink;
+   cppStreamed.sink = &cppSink;
+   cppKept.sink = &cppBuffer;
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&h, &cpp}) );
+   BOOST_CHECK( boiler::applyFilters(streamed, {&hStreamed, &cppStreamed, &cppKept}) );
+   BOOST_CHECK( hStreamed.filtered.empty() );
+   BOOST_CHECK( cppOutput.str() == cppBuffer.buffer );
+   auto hLines = lines(h.filtered);
+   auto hStreamedLines = lines(hOutput.str());
+   BOOST_CHECK( std::is_permutation(hStreamedLines.begin(), hStreamedLines.end(), hLines.begin(), hLines.end()) );
+   auto cppLines = lines(cpp.filtered);
+   auto cppStreamedLines = lines(cppOutput.str());
+   BOOST_CHECK( std::is_permutation(cppStreamedLines.begin(), cppStreamedLines.end(), cppLines.begin(), cppLines.end()) );
+   BOOST_CHECK( hOutput.str().find("struct Native {") < hOutput.str().find("struct Impression {") );
+   BOOST_CHECK( hOutput.str().find("struct Impression {") < hOutput.str().find("struct Data {") );
+
+   // errors as usual
+   boiler::JsonSchema missing{filename + ".missing", options};
+   BOOST_CHECK( missing.error == boiler::ParseErrorCode::UNABLE_OPEN_FILE );
+
+   // nowhere to write every object as soon as it is filtered
+   boiler::JsonSchema2H unsunk {};
+   BOOST_CHECK( not boiler::applyFilters(streamed, {&unsunk}) );
+   BOOST_CHECK( unsunk.error == boiler::ParseErrorCode::ERROR_FILTERING_DOCUMENT );
+
+   // "$ref" would not be followed
+   boiler::JsonSchema references{testFile("schemaRefs.json"), options};
+   BOOST_REQUIRE( references.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2H hReferences {};
+   boiler::JsonSchemaBufferSink referencesSink {};
+   hReferences.sink = &referencesSink;
+   BOOST_CHECK( not boiler::applyFilters(references, {&hReferences}) );
+   BOOST_CHECK( hReferences.error == boiler::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON );
+   BOOST_CHECK( hReferences.message.find("$ref") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( test013 ) {
+   BOOST_TEST_MESSAGE( "\ntest013: Fragments of unchanged objects reused from the previous run");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+   size_t objects {jsonSchema.objects.size()};
+   boiler::JsonSchema2H h {};
+   boiler::JsonSchema2CPP cpp {};
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&h, &cpp}) );
+
+   // first run: nothing to reuse, every object kept
+   boiler::JsonSchemaFragments hFragments {}, cppFragments {};
+   boiler::JsonSchema2H hFirst {};
+   boiler::JsonSchema2CPP cppFirst {};
+   hFirst.fragments = &hFragments;
+   cppFirst.fragments = &cppFragments;
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&hFirst, &cppFirst}) );
+   BOOST_CHECK( hFirst.filtered == h.filtered && cppFirst.filtered == cpp.filtered );
+   BOOST_CHECK( hFragments.reused == 0 && hFragments.current.size() == objects );
+   BOOST_CHECK( cppFragments.reused == 0 && cppFragments.current.size() == objects );
+
+   // second run, in parallel: everything reused, same output
+   hFragments.next();
+   cppFragments.next();
+   boiler::JsonSchema2H hSecond {};
+   boiler::JsonSchema2CPP cppSecond {};
+   hSecond.fragments = &hFragments;
+   cppSecond.fragments = &cppFragments;
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&hSecond, &cppSecond}, 2) );
+   BOOST_CHECK( hSecond.filtered == h.filtered && cppSecond.filtered == cpp.filtered );
+   BOOST_CHECK( hFragments.reused == objects && cppFragments.reused == objects );
+
+   // from one process to the next
+   std::string saved {filename + ".fragments"};
+   BOOST_CHECK( hFragments.save(saved) );
+   boiler::JsonSchemaFragments loaded {};
+   BOOST_CHECK( loaded.load(saved) );
+   BOOST_CHECK( loaded.previous.size() == objects );
+   BOOST_CHECK( not loaded.load(filename) ); // not a fragments file
+   BOOST_CHECK( loaded.previous.empty() );
+   BOOST_CHECK( loaded.load(saved) );
+
+   // a corrupt size: a cache miss, not a huge allocation
+   {
+	std::fstream corrupt {saved, std::ios::binary | std::ios::in | std::ios::out};
+	const uint64_t huge {~uint64_t{0} >> 1};
+	corrupt.seekp(std::strlen("boilerplateCodeDoc fragments 2\n") + sizeof(uint64_t)); // after the first key
+	corrupt.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+   }
+   boiler::JsonSchemaFragments corrupted {};
+   BOOST_CHECK_NO_THROW( BOOST_CHECK( not corrupted.load(saved) ) );
+   BOOST_CHECK( corrupted.previous.empty() );
+   std::remove(saved.c_str());
+
+   // a single property edited: only its object filtered again
+   std::string contents {};
+   {
+	std::ifstream json {filename};
+	contents.assign((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+   }
+   size_t edit {contents.find("Impressions rock")};
+   BOOST_REQUIRE( edit != std::string::npos );
+   contents.replace(edit, 16, "Impressions roll");
+   std::string edited {filename + ".edited.json"};
+   std::ofstream{edited}.write(contents.c_str(), contents.size());
+   boiler::JsonSchema editedSchema{edited};
+   std::remove(edited.c_str());
+   BOOST_REQUIRE( editedSchema.error == boiler::ParseErrorCode::OK );
+
+   boiler::JsonSchema2H hEdited {}, hReused {};
+   hReused.fragments = &loaded;
+   BOOST_CHECK( hEdited(editedSchema) && hReused(editedSchema) );
+   BOOST_CHECK( hReused.filtered == hEdited.filtered );
+   BOOST_CHECK( hReused.filtered != h.filtered );
+   BOOST_CHECK( loaded.reused == objects - 1 );
+}
+
+BOOST_AUTO_TEST_CASE( test014 ) {
+   BOOST_TEST_MESSAGE( "\ntest014: Synthetic schemas of the requested shape");
+
+   std::string filename{testFile("synthetic.json")};
+
+   auto load = [&filename](const boiler::JsonSchemaSynthetic& shape, size_t& properties, size_t& notImplemented) {
+	std::string json {boiler::syntheticSchema(shape)};
+	std::ofstream{filename}.write(json.c_str(), json.size());
+	boiler::JsonSchema jsonSchema{filename};
+	std::remove(filename.c_str());
+	BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+	properties = notImplemented = 0;
+	for(const auto& object : jsonSchema.objects) {
+		properties += object.properties.size();
+		notImplemented += std::count_if(object.properties.begin(), object.properties.end(), [](const auto& p){ return not p.implemented; });
+	}
+	boiler::JsonSchema2HTML html {};
+	boiler::JsonSchema2H h {};
+	boiler::JsonSchema2CPP cpp {};
+	BOOST_CHECK( boiler::applyFilters(jsonSchema, {&html, &h, &cpp}) );
+	return jsonSchema.objects.size();
+   };
+
+   boiler::JsonSchemaSynthetic shape {};
+   shape.depth = 4;
+   shape.breadth = 7;
+   shape.fanout = 3;
+   shape.description_length = 5;
+   shape.not_implemented = 100;
+   size_t properties {}, notImplemented {};
+   BOOST_CHECK( load(shape, properties, notImplemented) == shape.objects() );
+   BOOST_CHECK( properties == shape.properties() );
+   BOOST_CHECK( notImplemented == shape.breadth * shape.objects() );
+
+   shape.not_implemented = 0;
+   shape.one_of = 0;
+   BOOST_CHECK( load(shape, properties, notImplemented) == shape.objects() );
+   BOOST_CHECK( notImplemented == 0 );
+
+   // reproducible, but not the same for another seed
+   BOOST_CHECK( boiler::syntheticSchema(shape) == boiler::syntheticSchema(shape) );
+   boiler::JsonSchemaSynthetic other {shape};
+   other.seed = 2;
+   BOOST_CHECK( boiler::syntheticSchema(shape) != boiler::syntheticSchema(other) );
+
+   // no object at all: still valid json, rejected as a schema
+   shape.depth = 0;
+   BOOST_CHECK( shape.objects() == 0 && shape.properties() == 0 );
+   std::string json {boiler::syntheticSchema(shape)};
+   rapidjson::Document document {};
+   BOOST_CHECK( not document.Parse(json.c_str(), json.size()).HasParseError() );
+   std::ofstream{filename}.write(json.c_str(), json.size());
+   boiler::JsonSchema empty{filename};
+   std::remove(filename.c_str());
+   BOOST_CHECK( empty.error == boiler::ParseErrorCode::ERROR_PARSING_SCHEMA_JSON );
+}
+
+BOOST_AUTO_TEST_CASE( test015 ) {
+   BOOST_TEST_MESSAGE( "\ntest015: Phases measured while loading and filtering");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchemaStats stats {};
+   boiler::JsonSchemaOptions options {};
+   options.stats = &stats;
+   boiler::JsonSchema jsonSchema{filename, options};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+
+   // measured within the very same traversal, same output anyway
+   boiler::JsonSchema2H h {}, hMeasured {};
+   boiler::JsonSchema2CPP cpp {}, cppMeasured {};
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&h, &cpp}) );
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&hMeasured, &cppMeasured}, 0, &stats) );
+   BOOST_CHECK( hMeasured.filtered == h.filtered && cppMeasured.filtered == cpp.filtered );
+
+   std::vector<std::string> names {};
+   for(const auto& phase : stats.phases) {
+	names.push_back(phase.name);
+	BOOST_CHECK( phase.milliseconds >= 0 && phase.allocations == 0 ); // no probe, no allocations
+   }
+   BOOST_CHECK( names == std::vector<std::string>({"read", "parse", "compile", "filter", "h filter", "cpp filter", "h join", "cpp join"}) );
+   BOOST_CHECK( stats.phases[4].milliseconds + stats.phases[5].milliseconds <= stats.phases[3].milliseconds ); // shares of that traversal
+   BOOST_CHECK( lines(stats.text()).size() == stats.phases.size() + 1 );
+   BOOST_CHECK( stats.json().find("\"name\": \"cpp join\"") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( test016 ) {
+   BOOST_TEST_MESSAGE( "\ntest016: Documents of several schemas in a reused arena");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2H h {};
+   BOOST_CHECK( h(jsonSchema) );
+
+   // a small arena: the first document needs extra chunks, the next ones fit into a single buffer
+   boiler::JsonSchemaArena arena {1024};
+   size_t capacity {0};
+   for(int i = 0; i < 3; ++i) {
+	arena.reset();
+	if( i == 2 ) { BOOST_CHECK( arena.capacity() == capacity ); } // nothing else to grow
+	for(bool insitu : {true, false}) {
+		boiler::JsonSchemaOptions options {};
+		options.insitu = insitu;
+		boiler::JsonSchema arenaSchema{filename, arena, options};
+		BOOST_REQUIRE( arenaSchema.error == boiler::ParseErrorCode::OK );
+		boiler::JsonSchema2H arenaH {};
+		BOOST_CHECK( arenaH(arenaSchema) );
+		BOOST_CHECK( arenaH.filtered == h.filtered );
+	}
+	capacity = arena.capacity();
+   }
+   BOOST_CHECK( capacity > 1024 );
+}
+
+BOOST_AUTO_TEST_CASE( test017 ) {
+   BOOST_TEST_MESSAGE( "\ntest017: Output written piece by piece into sinks");
+
+   std::string filename{testFile("schema.json")};
+
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2HTML html {};
+   boiler::JsonSchema2CPP cpp {};
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&html, &cpp}) );
+
+   // nothing kept by the filters themselves
+   boiler::JsonSchemaBufferSink htmlBuffer {}, cppBuffer {};
+   boiler::JsonSchemaHashSink cppHash {};
+   boiler::JsonSchema2HTML htmlSunk {};
+   boiler::JsonSchema2CPP cppSunk {}, cppHashed {};
+   htmlSunk.sink = &htmlBuffer;
+   cppSunk.sink = &cppBuffer;
+   cppHashed.sink = &cppHash;
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&htmlSunk, &cppSunk, &cppHashed}, 2) );
+   BOOST_CHECK( htmlSunk.filtered.empty() && cppSunk.filtered.empty() );
+   BOOST_CHECK( htmlBuffer.buffer == html.filtered );
+   BOOST_CHECK( cppBuffer.buffer == cpp.filtered );
+   BOOST_CHECK( cppHash.size == cpp.filtered.size() && cppHash.hash == boiler::hash64(cpp.filtered) );
+
+   // serial and in visiting order: every object written as soon as it is filtered, not by end()
+   struct CountingSink final : public boiler::JsonSchemaSink {
+	using boiler::JsonSchemaSink::write;
+	bool write(const std::string_view*, size_t) override { ++writes; return true; }
+	size_t writes {0};
+   };
+   CountingSink counting {};
+   boiler::JsonSchema2HTML htmlCounted {};
+   htmlCounted.sink = &counting;
+   BOOST_CHECK( htmlCounted(jsonSchema) );
+   BOOST_CHECK( counting.writes == jsonSchema.objects.size() + 2 ); // header, objects, footer
+
+   // files: C streams and descriptors alike
+   std::FILE* file {std::tmpfile()};
+   BOOST_REQUIRE( file != nullptr );
+   auto contents = [&file]() {
+	std::string result(std::ftell(file), '\0');
+	std::rewind(file);
+	BOOST_CHECK( std::fread(&result[0], 1, result.size(), file) == result.size() );
+	return result;
+   };
+   boiler::JsonSchemaFileSink fileSink {file};
+   boiler::JsonSchema2HTML htmlFile {};
+   htmlFile.sink = &fileSink;
+   BOOST_CHECK( htmlFile(jsonSchema) );
+   BOOST_CHECK( contents() == html.filtered );
+#if defined(__unix__) || defined(__APPLE__)
+   std::fclose(file);
+   file = std::tmpfile();
+   BOOST_REQUIRE( file != nullptr );
+   boiler::JsonSchemaFdSink fdSink {fileno(file)};
+   boiler::JsonSchema2CPP cppFd {};
+   cppFd.sink = &fdSink;
+   BOOST_CHECK( cppFd(jsonSchema) );
+   BOOST_CHECK( fdSink.buffer.empty() && fdSink.calls > 0 );
+   std::fseek(file, 0, SEEK_END);
+   BOOST_CHECK( contents() == cpp.filtered );
+
+   // large pieces are not copied, yet written in order
+   std::fclose(file);
+   file = std::tmpfile();
+   BOOST_REQUIRE( file != nullptr );
+   fdSink.fd = fileno(file);
+   std::string large(boiler::JsonSchemaFdSink::CAPACITY, 'x');
+   std::string_view pieces[] {"a", large, "b", "c"};
+   BOOST_CHECK( fdSink.write(pieces, 4) && fdSink.buffer.empty() );
+   BOOST_CHECK( fdSink.write("d") && fdSink.buffer == "d" && fdSink.flush() );
+   std::fseek(file, 0, SEEK_END);
+   BOOST_CHECK( contents() == "a" + large + "bcd" );
+#endif
+   std::fclose(file);
+}
+
+BOOST_AUTO_TEST_CASE( test018 ) {
+   BOOST_TEST_MESSAGE( "\ntest018: Generated SAX reader decoding Data straight from a json buffer");
+
+   namespace example = boilerplate::Example;
+
+   // unknown members of any kind are skipped, not implemented ones (banner) too
+   const std::string request {R"({
+	"id": "request",
+	"unknown": {"nested": [1, {"deeper": [true, null]}], "id": "not this one"},
+	"test": 1,
+	"imp": [
+		{
+			"id": "1", "bidfloor": 2, "bidfloorcur": "EUR", "exp": -30, "secure": null,
+			"banner": {"w": 300, "h": 250},
+			"iframabuster": ["a", "b"],
+			"ext": {"strictbannersize": 1},
+			"native": {"request": "{}", "ver": "1.2", "api": [3, 5]},
+			"pmp": {"private_auction": 1, "deals": [
+				{"id": "d1", "bidfloor": 1.5, "at": 2, "wseat": ["s1", "s2"]},
+				{"id": "d2", "wadomain": ["example.com"], "extra": [[]]}
+			]}
+		},
+		{"id": "2", "tagid": "slot"}
+	]
+   })"};
+
+   example::Data data {};
+   BOOST_REQUIRE( example::getData(request.c_str(), request.size(), data) );
+   BOOST_CHECK( data.id == "request" && data.test == 1 );
+   BOOST_REQUIRE( data.imp.size() == 2 );
+   const example::Impression& imp {data.imp[0]};
+   BOOST_CHECK( imp.id == "1" && imp.bidfloor == 2.0 && imp.bidfloorcur == "EUR" && imp.exp == -30 && imp.secure == 0 );
+   BOOST_CHECK( imp.iframabuster == (std::vector<std::string>{"a", "b"}) );
+   BOOST_CHECK( imp.ext.strictbannersize == 1 );
+   BOOST_CHECK( imp.native.request == "{}" && imp.native.ver == "1.2" && imp.native.api == (std::vector<unsigned int>{3, 5}) );
+   BOOST_CHECK( imp.pmp.private_auction == 1 );
+   BOOST_REQUIRE( imp.pmp.deals.size() == 2 );
+   BOOST_CHECK( imp.pmp.deals[0].id == "d1" && imp.pmp.deals[0].bidfloor == 1.5 && imp.pmp.deals[0].at == 2 );
+   BOOST_CHECK( imp.pmp.deals[0].wseat == (std::vector<std::string>{"s1", "s2"}) );
+   BOOST_CHECK( imp.pmp.deals[1].id == "d2" && imp.pmp.deals[1].wadomain == std::vector<std::string>{"example.com"} );
+   BOOST_CHECK( data.imp[1].id == "2" && data.imp[1].tagid == "slot" && data.imp[1].pmp.deals.empty() );
+
+   // not null terminated
+   const std::string prefix {R"({"id": "x"}garbage)"};
+   example::Data partial {};
+   BOOST_CHECK( example::getData(prefix.c_str(), 11, partial) && partial.id == "x" );
+
+   // wrong types and invalid json
+   for(const std::string& wrong : {R"({"id": 1})", R"({"test": -1})", R"({"test": 1.5})", R"({"imp": {}})",
+				   R"({"imp": [1]})", R"({"imp": [{"pmp": []}]})", R"([])", R"("id")", R"({"id": "x")", ""}) {
+	example::Data invalid {};
+	BOOST_CHECK_MESSAGE( not example::getData(wrong.c_str(), wrong.size(), invalid), wrong );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test019 ) {
+   BOOST_TEST_MESSAGE( "\ntest019: Generated getData walking an already parsed document");
+
+   namespace example = boilerplate::Example;
+
+   const std::string request {R"({
+	"id": "request", "unknown": [{"id": "not this one"}], "test": 1,
+	"imp": [{
+		"id": "1", "bidfloor": 2, "exp": -30, "secure": null, "banner": {"w": 300},
+		"native": {"ver": "1.2", "api": [3, 5]},
+		"pmp": {"private_auction": 1, "deals": [{"id": "d1", "bidfloor": 1.5, "wseat": ["s1", "s2"]}]}
+	}]
+   })"};
+   rapidjson::Document document {};
+   BOOST_REQUIRE( not document.Parse(request.c_str(), request.size()).HasParseError() );
+
+   // same decoding as the SAX reader, from the members the document already has
+   example::Data sax {}, dom {};
+   BOOST_REQUIRE( example::getData(request.c_str(), request.size(), sax) );
+   BOOST_REQUIRE( example::getData(&document, dom) );
+   BOOST_CHECK( dom.id == sax.id && dom.id == "request" && dom.test == 1 );
+   BOOST_REQUIRE( dom.imp.size() == 1 );
+   const example::Impression& imp {dom.imp[0]};
+   BOOST_CHECK( imp.id == "1" && imp.bidfloor == 2.0 && imp.exp == -30 && imp.secure == 0 );
+   BOOST_CHECK( imp.native.ver == "1.2" && imp.native.api == sax.imp[0].native.api );
+   BOOST_REQUIRE( imp.pmp.deals.size() == 1 );
+   BOOST_CHECK( imp.pmp.private_auction == 1 && imp.pmp.deals[0].id == "d1" && imp.pmp.deals[0].bidfloor == 1.5 );
+   BOOST_CHECK( imp.pmp.deals[0].wseat == sax.imp[0].pmp.deals[0].wseat );
+
+   // documents built by hand too
+   example::Data nested {};
+   document.SetObject().AddMember("id", rapidjson::Value{"x"}, document.GetAllocator());
+   BOOST_CHECK( example::getData(&document, nested) && nested.id == "x" );
+
+   // wrong types
+   for(const std::string& wrong : {R"({"id": 1})", R"({"test": -1})", R"({"imp": {}})", R"({"imp": [{"pmp": []}]})", R"([])"}) {
+	rapidjson::Document invalid {};
+	BOOST_REQUIRE( not invalid.Parse(wrong.c_str()).HasParseError() );
+	example::Data data {};
+	BOOST_CHECK_MESSAGE( not example::getData(&invalid, data), wrong );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test020 ) {
+   BOOST_TEST_MESSAGE( "\ntest020: View flavour of the generated structs, parsed in place");
+
+   namespace example = boilerplate::Example;
+
+   // parsed in place: views point into the buffer, escaped strings included
+   std::string request {R"({
+	"id": "request", "unknown": {"id": "not this one"},
+	"imp": [{
+		"id": "1", "bidfloorcur": "EUR", "tagid": "a\"b", "bidfloor": 2,
+		"pmp": {"deals": [{"id": "d1", "wseat": ["s1", "s2"]}]}
+	}]
+   })"};
+   example::view::Data view {};
+   BOOST_REQUIRE( example::getData(&request[0], view) );
+   BOOST_CHECK( view.id == "request" );
+   BOOST_CHECK( view.id.data() >= request.data() && view.id.data() < request.data() + request.size() );
+   BOOST_REQUIRE( view.imp.size() == 1 );
+   BOOST_CHECK( view.imp[0].id == "1" && view.imp[0].bidfloorcur == "EUR" && view.imp[0].tagid == "a\"b" && view.imp[0].bidfloor == 2.0 );
+   BOOST_REQUIRE( view.imp[0].pmp.deals.size() == 1 );
+   BOOST_CHECK( view.imp[0].pmp.deals[0].id == "d1" );
+   BOOST_CHECK( view.imp[0].pmp.deals[0].wseat == (std::vector<std::string_view>{"s1", "s2"}) );
+
+   // views into a document
+   const std::string json {R"({"id": "x", "imp": [{"native": {"ver": "1.2"}}]})"};
+   rapidjson::Document document {};
+   BOOST_REQUIRE( not document.Parse(json.c_str()).HasParseError() );
+   example::view::Data fromDocument {};
+   BOOST_REQUIRE( example::getData(&document, fromDocument) );
+   BOOST_CHECK( fromDocument.id == "x" && fromDocument.id.data() == document["id"].GetString() );
+   BOOST_REQUIRE( fromDocument.imp.size() == 1 );
+   BOOST_CHECK( fromDocument.imp[0].native.ver == "1.2" );
+
+   // wrong types
+   std::string wrong {R"({"imp": [{"id": 1}]})"};
+   example::view::Data invalid {};
+   BOOST_CHECK( not example::getData(&wrong[0], invalid) );
+
+   // only the generated code depends on the filter option
+   std::string filename{testFile("schema.json")};
+   boiler::JsonSchema jsonSchema{filename};
+   BOOST_REQUIRE( jsonSchema.error == boiler::ParseErrorCode::OK );
+   boiler::JsonSchema2H h {}, hViews {};
+   boiler::JsonSchema2CPP cpp {}, cppViews {};
+   hViews.views = cppViews.views = true;
+   BOOST_CHECK( boiler::applyFilters(jsonSchema, {&h, &hViews, &cpp, &cppViews}) );
+   BOOST_CHECK( h.options().empty() && hViews.options() == "views" );
+   BOOST_CHECK( h.filtered.find("string_view") == std::string::npos && cpp.filtered.find("TYPE_view_") == std::string::npos );
+   BOOST_CHECK( hViews.filtered.find("namespace boilerplate::Example::view {") != std::string::npos );
+   BOOST_CHECK( hViews.filtered.find("#include <string_view>") != std::string::npos );
+   BOOST_CHECK( cppViews.filtered.find("TYPE_view_Data") != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( test021 ) {
+   BOOST_TEST_MESSAGE( "\ntest021: Generated structs with std::pmr containers, a whole request in one memory resource");
+
+   namespace example = boilerplatePmr::Example;
+
+   const std::string request {R"({
+	"id": "request",
+	"imp": [
+		{"id": "1", "iframabuster": ["a", "b"], "native": {"api": [3, 5]},
+		 "pmp": {"deals": [{"id": "d1", "wseat": ["a long enough seat name not to fit in small string storage"]}]}},
+		{"id": "2", "pmp": {"deals": [{"id": "d2"}, {"id": "d3"}]}}
+	]
+   })"};
+
+   // nothing but the resource allocates: its upstream refuses to
+   alignas(std::max_align_t) char buffer[64 * 1024];
+   std::pmr::monotonic_buffer_resource resource {buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+   example::Data data {&resource};
+   BOOST_REQUIRE( example::getData(request.c_str(), request.size(), data) );
+   BOOST_CHECK( data.id == "request" && data.imp.get_allocator().resource() == &resource );
+   BOOST_REQUIRE( data.imp.size() == 2 );
+   BOOST_CHECK( data.imp[0].iframabuster.size() == 2 && data.imp[0].iframabuster[1] == "b" );
+   BOOST_CHECK( data.imp[0].native.api.size() == 2 && data.imp[0].native.api[1] == 5 );
+   BOOST_REQUIRE( data.imp[0].pmp.deals.size() == 1 && data.imp[0].pmp.deals[0].wseat.size() == 1 );
+   const auto& seat = data.imp[0].pmp.deals[0].wseat[0];
+   BOOST_CHECK( seat.get_allocator().resource() == &resource );
+   BOOST_CHECK( seat.data() >= buffer && seat.data() < buffer + sizeof(buffer) );
+   BOOST_REQUIRE( data.imp[1].pmp.deals.size() == 2 );
+   BOOST_CHECK( data.imp[1].pmp.deals[1].id == "d3" && data.imp[1].pmp.deals[1].id.get_allocator().resource() == &resource );
+
+   // copies into another resource, moves keep theirs
+   example::Data copy {data, std::pmr::new_delete_resource()};
+   BOOST_CHECK( copy.imp.get_allocator().resource() == std::pmr::new_delete_resource() && copy.imp[1].pmp.deals[1].id == "d3" );
+   BOOST_CHECK( copy.imp[0].pmp.deals[0].wseat[0].get_allocator().resource() == std::pmr::new_delete_resource() );
+   example::Data moved {std::move(copy)};
+   BOOST_CHECK( moved.imp.get_allocator().resource() == std::pmr::new_delete_resource() && moved.imp.size() == 2 );
+
+   // views too
+   std::string insitu {request};
+   example::view::Data view {&resource};
+   BOOST_REQUIRE( example::getData(&insitu[0], view) );
+   BOOST_CHECK( view.imp.size() == 2 && view.imp[0].iframabuster[0] == "a" && view.imp.get_allocator().resource() == &resource );
+}
+
+BOOST_AUTO_TEST_CASE( test022 ) {
+   BOOST_TEST_MESSAGE( "\ntest022: Generated json writer, read back by the generated reader");
+
+   namespace example = boilerplate::Example;
+
+   example::Data data {};
+   data.id = "quote \" backslash \\ newline \n control \x01";
+   data.test = 1;
+   data.imp.resize(2);
+   data.imp[0].id = "1";
+   data.imp[0].bidfloor = 2.5;
+   data.imp[0].exp = -30;
+   data.imp[0].iframabuster = {"a", "b"};
+   data.imp[0].native.api = {3, 5};
+   data.imp[0].pmp.deals.resize(2);
+   data.imp[0].pmp.deals[0].id = "d1";
+   data.imp[0].pmp.deals[0].wseat = {"s1"};
+   data.imp[0].pmp.deals[1].bidfloor = 1e-7;
+   data.imp[1].tagid = "slot";
+
+   std::string json {"prefix "};
+   BOOST_REQUIRE( example::setData(data, json) );
+   BOOST_CHECK( json.compare(0, 7, "prefix ") == 0 ); // appended to
+   json.erase(0, 7);
+   const std::string start {R"({"id":"quote \" backslash \\ newline \n control \u0001","imp":[{"bidfloor":2.5,)"};
+   BOOST_CHECK( json.compare(0, start.size(), start) == 0 );
+   BOOST_CHECK( json.find(R"("exp":-30,)") != std::string::npos );
+   BOOST_CHECK( json.find(R"("iframabuster":["a","b"],)") != std::string::npos );
+   BOOST_CHECK( json.find(R"("bidfloor":1e-7,)") != std::string::npos );
+
+   // same text as rapidjson itself
+   rapidjson::Document document {};
+   BOOST_REQUIRE( not document.Parse(json.c_str(), json.size()).HasParseError() );
+   rapidjson::StringBuffer buffer {};
+   rapidjson::Writer<rapidjson::StringBuffer> writer {buffer};
+   BOOST_REQUIRE( document.Accept(writer) );
+   BOOST_CHECK( json == std::string(buffer.GetString(), buffer.GetSize()) );
+
+   // and once read back
+   example::Data read {};
+   BOOST_REQUIRE( example::getData(json.c_str(), json.size(), read) );
+   std::string again {};
+   BOOST_REQUIRE( example::setData(read, again) );
+   BOOST_CHECK( again == json );
+   BOOST_CHECK( read.id == data.id && read.imp[0].pmp.deals[1].bidfloor == 1e-7 && read.imp[0].native.api == data.imp[0].native.api );
+   BOOST_CHECK( read.imp[1].tagid == "slot" );
+
+   // view and pmr flavours write the same text
+   std::string insitu {json};
+   example::view::Data view {};
+   BOOST_REQUIRE( example::getData(&insitu[0], view) );
+   std::string fromView {};
+   BOOST_REQUIRE( example::setData(view, fromView) && fromView == json );
+
+   boilerplatePmr::Example::Data pmr {};
+   BOOST_REQUIRE( boilerplatePmr::Example::getData(json.c_str(), json.size(), pmr) );
+   std::string fromPmr {};
+   BOOST_REQUIRE( boilerplatePmr::Example::setData(pmr, fromPmr) && fromPmr == json );
+
+   // no json for them
+   example::Data infinite {};
+   infinite.imp.resize(1);
+   infinite.imp[0].bidfloor = std::numeric_limits<double>::infinity();
+   std::string nulled {};
+   BOOST_REQUIRE( example::setData(infinite, nulled) );
+   BOOST_CHECK( nulled.find(R"({"bidfloor":null,)") != std::string::npos );
+
+   // empty one
+   std::string empty {};
+   BOOST_REQUIRE( example::setData(example::Data{}, empty) );
+   BOOST_CHECK( empty == R"({"id":"","imp":[],"test":0})" );
+}